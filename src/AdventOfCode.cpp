@@ -15,17 +15,57 @@
 //=== Include ================================================================
 #include <fstream>
 #include <iostream>
+#include <string_view>
 
 #include "aoc/Aoc.h"
 #include "aoc/BasicDefinitions.h"
+#include "aoc/InputScanner.h"
 
 #include <vector>
 #include <algorithm>
 
 
 
+namespace {
+//=== Functions ==============================================================
+// --- parseYear() ---
+// Returns false, if argument is not a year of the enum
+bool parseYear(std::string_view argument, aoc::EYears& year)
+{
+	int value {0};
+	if (!aoc::parseInt(argument, value) || value < static_cast<int>(aoc::EYears::Year2015)
+			|| value > static_cast<int>(aoc::EYears::Year2021)) {
+		return false;
+	}
+
+	year = static_cast<aoc::EYears>(value);
+	return true;
+}
+
+
+
+// --- parseDay() ---
+// Returns false, if argument is not a day of the enum
+bool parseDay(std::string_view argument, aoc::EDays& day)
+{
+	int value {0};
+	if (!aoc::parseInt(argument, value) || value < static_cast<int>(aoc::EDays::Day01)
+			|| value > static_cast<int>(aoc::EDays::Day25)) {
+		return false;
+	}
+
+	day = static_cast<aoc::EDays>(value);
+	return true;
+}
+
+
+
+} /* anonymous namespace */
+
+
+
 //=== main() =================================================================
-int main() {
+int main(int argc, char* argv[]) {
 	std::ios_base::sync_with_stdio(false);
 
 
@@ -39,8 +79,25 @@ int main() {
 
 
 	std::cout << "Advent of Code (adventofcode.com):\n";
-	// TODO: Loop through all puzzles
-	aoc::solvePuzzle(aoc::EYears::Year2015, aoc::EDays::Day23);
+	aoc::EYears year {aoc::EYears::Year2015};
+	aoc::EDays day {aoc::EDays::Day01};
+	if (argc == 3) {	// Solve a single puzzle: AdventOfCode <year> <day>
+		if (parseYear(argv[1], year) && parseDay(argv[2], day)) {
+			aoc::solvePuzzle(year, day);
+		} else {
+			std::cout << "Invalid arguments, expected: <year 2015..2021> <day 1..25>\n";
+		}
+	} else if (argc == 2 && std::string_view {argv[1]} == "list") {
+		aoc::printPuzzles();
+	} else if (argc == 2) {	// Solve all puzzles of a year: AdventOfCode <year>
+		if (parseYear(argv[1], year)) {
+			aoc::solveAllPuzzles(year);
+		} else {
+			std::cout << "Invalid argument, expected: <year 2015..2021> or list\n";
+		}
+	} else {
+		aoc::solveAllPuzzles(year);
+	}
 
 
 #ifdef FILE_OUTPUT
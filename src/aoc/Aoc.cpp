@@ -6,34 +6,139 @@
 //=== Include ================================================================
 #include "Aoc.h"
 
+#include <algorithm>
+#include <future>
 #include <iostream>
+#include <iterator>
+#include <sstream>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "BasicDefinitions.h"
+#include "BasicIO.h"
+#include "PuzzleRegistry.h"
+#include "ThreadPool.h"
 
 #include "../aoc2015/Aoc2015.h"
 
 
 
 namespace aoc {
+namespace {
+
+
+
+//=== Constants ==============================================================
+// All registered puzzles, further years have to be joined here
+constexpr auto& all_puzzles {aoc2015::puzzles_2015};
+
+
+
 //=== Function ===============================================================
+// --- findPuzzle() ---
+// Returns nullptr, if the puzzle is not registered
+const SPuzzle* findPuzzle(const aoc::EYears year, const aoc::EDays day)
+{
+	const auto result {std::find_if(all_puzzles.cbegin(), all_puzzles.cend(), [year, day](const auto& puzzle) {
+		return puzzle.year == year && puzzle.day == day;
+	})};
+	return result != all_puzzles.cend() ? &*result : nullptr;
+}
+
+
+
+// --- getPuzzles() ---
+std::vector<SPuzzle> getPuzzles(const aoc::EYears year)
+{
+	std::vector<SPuzzle> result {};
+	std::copy_if(all_puzzles.cbegin(), all_puzzles.cend(), std::back_inserter(result), [year](const auto& puzzle) {
+		return puzzle.year == year;
+	});
+
+	if (result.empty()) {
+		throw std::runtime_error("This year was not (yet) solved.");
+	}
+	return result;
+}
+
+
+
+} /* anonymous namespace */
+
+
+
+//=== Function ===============================================================
+// --- solvePuzzle() ---
 void solvePuzzle(const aoc::EYears year, const aoc::EDays day)
 {
-	try {
-		switch (year) {
-		case EYears::Year2015:
-			aoc2015::solvePuzzle2015(day);
-			break;
+	std::ostream& output {BasicIO::getOutput()};
 
-		default:
-			throw std::runtime_error("This year was not (yet) solved.");
+	try {
+		const auto puzzle {findPuzzle(year, day)};
+		if (puzzle == nullptr) {
+			throw std::runtime_error("This puzzle was not (yet) solved.");
 		}
+		puzzle->create()->solve();
 
 	} catch (std::exception& e) {
-		std::cout << "Year " << static_cast<int>(year) << " Day " << static_cast<int>(day)
+		output << "Year " << static_cast<int>(year) << " Day " << static_cast<int>(day)
 				<< " Error: could not solve.\n\t" << e.what() << '\n';
 	}
-	std::cout << '\n';
+	output << '\n';
+}
+
+
+
+// --- solveAllPuzzles() ---
+// Each puzzle is solved by a worker of the shared thread pool, which also runs the parallel parts of the puzzles.
+// The output is buffered and printed in order of the days.
+void solveAllPuzzles(const aoc::EYears year)
+{
+	try {
+		const std::vector<SPuzzle> puzzles {getPuzzles(year)};
+		std::vector<std::future<std::string> > outputs {};
+		outputs.reserve(puzzles.size());
+
+		ThreadPool& pool {ThreadPool::getShared()};
+		for (const auto& puzzle : puzzles) {
+			outputs.push_back(pool.addTask([year, day = puzzle.day]() {
+				std::ostringstream output {};
+				BasicIO::setOutput(&output);
+				solvePuzzle(year, day);		// does not throw
+				BasicIO::setOutput(nullptr);
+				return output.str();
+			}));
+		}
+
+		// Print while the pool is still working on later days
+		for (auto& output : outputs) {
+			std::cout << output.get() << std::flush;
+		}
+
+	} catch (std::exception& e) {
+		std::cout << "Year " << static_cast<int>(year) << " Error: could not solve.\n\t" << e.what() << "\n\n";
+	}
+}
+
+
+
+// --- printPuzzles() ---
+// Lists all registered puzzles without creating them
+void printPuzzles()
+{
+	std::ostream& output {BasicIO::getOutput()};
+
+	output << "Solved puzzles:";
+	const SPuzzle* prev {nullptr};
+	for (const auto& puzzle : all_puzzles) {
+		if (prev == nullptr || prev->year != puzzle.year) {
+			output << "\n\t" << static_cast<int>(puzzle.year) << ":";
+		}
+		output << ' ' << static_cast<int>(puzzle.day);
+		prev = &puzzle;
+	}
+	output << "\n\n";
 }
 
 
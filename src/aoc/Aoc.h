@@ -17,6 +17,8 @@
 namespace aoc {
 //=== Function ===============================================================
 void solvePuzzle(const aoc::EYears year, const aoc::EDays day);
+void solveAllPuzzles(const aoc::EYears year);		// solves the puzzles of all days in parallel
+void printPuzzles();								// lists all solved puzzles
 
 
 
@@ -11,16 +11,31 @@
 #include <string_view>
 
 #include "BasicDefinitions.h"
+#include "MappedFile.h"
 #include "Timer.h"
 
 
 
 namespace aoc {
+namespace {
+
+
+
+//=== Variables ==============================================================
+// Each thread may solve a different puzzle, so each thread needs its own output
+thread_local std::ostream* t_output {nullptr};
+
+
+
+} /* anonymous namespace */
+
+
+
 //=== Class BasicIO ============================================================
 // --- BasicIO::BasicIO() ---
 BasicIO::BasicIO(const EYears year, const EDays day) : m_year(year), m_day(day)
 {
-	std::cout << "Year " << static_cast<int>(m_year) << " Day " << static_cast<int>(m_day) << ":\n";
+	getOutput() << "Year " << static_cast<int>(m_year) << " Day " << static_cast<int>(m_day) << ":\n";
 }
 
 
@@ -30,11 +45,7 @@ std::ifstream BasicIO::getInputFile() const
 {
 	using namespace std::string_literals;
 
-	const std::string day_num {m_day < aoc::EDays::Day10
-		? "0"s + std::to_string(static_cast<int>(m_day)) // File names should be 'Day01', ...
-		: std::to_string(static_cast<int>(m_day))};
-	const std::string file_name {".\\input\\"s + std::to_string(static_cast<int>(m_year)) + "\\" + "Day"s + day_num + ".txt"s};
-
+	const std::string file_name {getFileName()};
 	std::ifstream result(file_name);
 	EXPECT(result.is_open(), "Could not open file: "s + file_name);
 	return result;
@@ -45,9 +56,35 @@ std::ifstream BasicIO::getInputFile() const
 // --- BasicIO::getInputString() ---
 std::string BasicIO::getInputString() const
 {
-	std::string result {};
-	getInputFile() >> result;
-	return result;
+	return std::string {getInputToken()};
+}
+
+
+
+// --- BasicIO::getInputData() ---
+std::string_view BasicIO::getInputData() const
+{
+	if (!m_inputData.isOpen()) {
+		m_inputData.open(getFileName());
+	}
+	return m_inputData.getData();
+}
+
+
+
+// --- BasicIO::getInputToken() ---
+std::string_view BasicIO::getInputToken() const
+{
+	constexpr std::string_view whitespace {" \t\n\v\f\r"};
+
+	auto result {getInputData()};
+	const auto first {result.find_first_not_of(whitespace)};
+	if (first == std::string_view::npos) {
+		return std::string_view {};
+	}
+
+	result.remove_prefix(first);
+	return result.substr(0, result.find_first_of(whitespace));
 }
 
 
@@ -55,7 +92,7 @@ std::string BasicIO::getInputString() const
 // --- BasicIO::printFileValid() ---
 void BasicIO::printFileValid() const
 {
-	std::cout << "\tLoaded and validated input file: ";
+	getOutput() << "\tLoaded and validated input file: ";
 	timeStamp();
 }
 
@@ -64,7 +101,36 @@ void BasicIO::printFileValid() const
 // --- BasicIO::printError() ---
 void BasicIO::printError(std::string_view error) const
 {
-	std::cout << "\tCould not solve puzzle.\n\t" << error << '\n';
+	getOutput() << "\tCould not solve puzzle.\n\t" << error << '\n';
+}
+
+
+
+// --- BasicIO::getOutput() ---
+std::ostream& BasicIO::getOutput()
+{
+	return (t_output != nullptr) ? *t_output : std::cout;
+}
+
+
+
+// --- BasicIO::setOutput() ---
+void BasicIO::setOutput(std::ostream* output)
+{
+	t_output = output;
+}
+
+
+
+// --- BasicIO::getFileName() ---
+std::string BasicIO::getFileName() const
+{
+	using namespace std::string_literals;
+
+	const std::string day_num {m_day < aoc::EDays::Day10
+		? "0"s + std::to_string(static_cast<int>(m_day)) // File names should be 'Day01', ...
+		: std::to_string(static_cast<int>(m_day))};
+	return ".\\input\\"s + std::to_string(static_cast<int>(m_year)) + "\\" + "Day"s + day_num + ".txt"s;
 }
 
 
@@ -76,7 +142,7 @@ void BasicIO::timeStamp() const
 	constexpr int float_width {8};
 	constexpr int time_width {24};
 
-	std::cout << std::fixed << std::setprecision(float_precision) << std::setw(time_width)
+	getOutput() << std::fixed << std::setprecision(float_precision) << std::setw(time_width)
 			<< "Time: " << std::setw(float_width) << m_timer.elapsed() << " s\n";
 }
 
@@ -14,6 +14,7 @@
 #include <string_view>
 
 #include "BasicDefinitions.h"
+#include "MappedFile.h"
 #include "Timer.h"
 
 
@@ -38,14 +39,20 @@ public:
 
 // Functions
 	std::ifstream getInputFile() const;
-	std::string getInputString() const;		// only reads to the first whitespace
+	std::string getInputString() const;			// only reads to the first whitespace
+	std::string_view getInputData() const;		// whole file without copying it, valid as long as this object
+	std::string_view getInputToken() const;		// getInputData() up to the first whitespace
 	void printFileValid() const;
 	template<typename T> void printSolution(const T solution, const EPart part) const;
 	void printError(std::string_view error) const;
 
+	static std::ostream& getOutput();				// output of the current thread (default: std::cout)
+	static void setOutput(std::ostream* output);	// nullptr resets the output to std::cout
+
 
 private:
 // Functions
+	std::string getFileName() const;
 	void timeStamp() const;
 
 
@@ -53,6 +60,7 @@ private:
 	Timer m_timer {};		// To calculate timing of the code
 	const EYears m_year;	// Which puzzle is solved?
 	const EDays m_day;		// Which puzzle is solved?
+	mutable MappedFile m_inputData {};		// Mapped at the first call of getInputData()
 };
 
 
@@ -63,7 +71,7 @@ void BasicIO::printSolution(const T solution, const EPart part) const
 {
 	constexpr int solution_width {16};
 
-	std::cout << "\tPart " << static_cast<int>(part) << " solution: " << std::setw(solution_width) << solution;
+	getOutput() << "\tPart " << static_cast<int>(part) << " solution: " << std::setw(solution_width) << solution;
 	timeStamp();
 }
 
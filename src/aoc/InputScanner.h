@@ -0,0 +1,283 @@
+// InputScanner.h
+/* zero-copy parsing of input data: lines, whitespace separated tokens and integers as views into the input buffer */
+
+
+
+//=== Preprocessor ===========================================================
+#ifndef AOC_INPUTSCANNER_H_
+#define AOC_INPUTSCANNER_H_
+
+
+
+//=== Include ================================================================
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include "BasicDefinitions.h"
+
+
+
+namespace aoc {
+//=== Functions ==============================================================
+// --- parseInt() ---
+// Returns false, if data is not exactly one integer
+template<typename T>
+bool parseInt(std::string_view data, T& value)
+{
+	if (!data.empty() && data.front() == '+') {    // from_chars does not accept a plus sign
+		data.remove_prefix(1);
+	}
+
+	const auto [end, error] {std::from_chars(data.data(), data.data() + data.length(), value)};
+	return error == std::errc {} && end == data.data() + data.length();
+}
+
+
+
+//=== Class LineIterator =====================================================
+// Iterates over all lines of a buffer, "\n" and "\r\n" are both accepted. A line break at the end does not add an empty line.
+class LineIterator final {
+public:
+// Types
+	using iterator_category = std::forward_iterator_tag;
+	using value_type = std::string_view;
+	using difference_type = std::ptrdiff_t;
+	using pointer = const std::string_view*;
+	using reference = const std::string_view&;
+
+
+// Constructors / destructor
+	LineIterator() = default;    // end iterator
+
+
+	// --- LineIterator() ---
+	explicit LineIterator(std::string_view data) : m_rest {data}, m_isEnd {false}
+	{
+		next();
+	}
+
+
+// Operators
+	// --- operator*() ---
+	reference operator*() const
+	{
+		return m_line;
+	}
+
+
+	// --- operator->() ---
+	pointer operator->() const
+	{
+		return &m_line;
+	}
+
+
+	// --- operator++() ---
+	LineIterator& operator++()
+	{
+		next();
+		return *this;
+	}
+
+
+	// --- operator++(int) ---
+	LineIterator operator++(int)
+	{
+		LineIterator result {*this};
+		next();
+		return result;
+	}
+
+
+	// --- operator==() ---
+	bool operator==(const LineIterator& other) const
+	{
+		return m_isEnd == other.m_isEnd && (m_isEnd || m_rest.data() == other.m_rest.data());
+	}
+
+
+	// --- operator!=() ---
+	bool operator!=(const LineIterator& other) const
+	{
+		return !(*this == other);
+	}
+
+
+private:
+// Functions
+	// --- next() ---
+	void next()
+	{
+		if (m_rest.empty()) {
+			m_isEnd = true;
+			return;
+		}
+
+		const auto pos {m_rest.find('\n')};
+		m_line = m_rest.substr(0, pos);
+		m_rest.remove_prefix(pos == std::string_view::npos ? m_rest.length() : pos + 1);
+
+		if (!m_line.empty() && m_line.back() == '\r') {
+			m_line.remove_suffix(1);
+		}
+	}
+
+
+// Variables
+	std::string_view m_rest {};		// Data behind the current line
+	std::string_view m_line {};		// Current line
+	bool m_isEnd {true};
+};
+
+
+
+//=== Class Lines ============================================================
+// Range of the lines of data, e.g. for (const auto line : Lines {data})
+class Lines final {
+public:
+// Constructors / destructor
+	// --- Lines() ---
+	explicit Lines(std::string_view data) : m_data {data}
+	{
+	}
+
+
+// Functions
+	// --- begin() ---
+	LineIterator begin() const
+	{
+		return LineIterator {m_data};
+	}
+
+
+	// --- end() ---
+	LineIterator end() const
+	{
+		return LineIterator {};
+	}
+
+
+private:
+// Variables
+	std::string_view m_data {};
+};
+
+
+
+//=== Class TokenScanner =====================================================
+// Reads whitespace separated tokens, integers and fixed strings from data. Throws, if data does not match.
+class TokenScanner final {
+public:
+// Constructors / destructor
+	// --- TokenScanner() ---
+	explicit TokenScanner(std::string_view data) : m_rest {data}
+	{
+	}
+
+
+// Getter
+	// --- isEnd() ---
+	// Only whitespace is left
+	bool isEnd()
+	{
+		skipWhitespace();
+		return m_rest.empty();
+	}
+
+
+	// --- getRest() ---
+	std::string_view getRest() const
+	{
+		return m_rest;
+	}
+
+
+// Functions
+	// --- nextToken() ---
+	std::string_view nextToken()
+	{
+		skipWhitespace();
+		EXPECT(!m_rest.empty(), invalid_input_file_data);
+
+		const auto length {std::min(m_rest.find_first_of(whitespace), m_rest.length())};
+		const auto result {m_rest.substr(0, length)};
+		m_rest.remove_prefix(length);
+		return result;
+	}
+
+
+	// --- nextInt() ---
+	// Reads an integer, it may be directly followed by other characters like "2x3"
+	template<typename T>
+	T nextInt()
+	{
+		skipWhitespace();
+		if (!m_rest.empty() && m_rest.front() == '+') {
+			m_rest.remove_prefix(1);
+		}
+
+		T result {};
+		const auto [end, error] {std::from_chars(m_rest.data(), m_rest.data() + m_rest.length(), result)};
+		EXPECT(error == std::errc {}, invalid_input_file_data);
+
+		m_rest.remove_prefix(static_cast<std::string_view::size_type>(end - m_rest.data()));
+		return result;
+	}
+
+
+	// --- skip() ---
+	// Skips whitespace and the expected string
+	void skip(std::string_view expected)
+	{
+		EXPECT(skipIf(expected), invalid_input_file_data);
+	}
+
+
+	// --- skipIf() ---
+	// Like skip(), but returns false instead of throwing
+	bool skipIf(std::string_view expected)
+	{
+		if (!isNext(expected)) {
+			return false;
+		}
+
+		m_rest.remove_prefix(expected.length());
+		return true;
+	}
+
+
+	// --- isNext() ---
+	// Skips whitespace and checks, if expected follows, without skipping it
+	bool isNext(std::string_view expected)
+	{
+		skipWhitespace();
+		return m_rest.substr(0, expected.length()) == expected;
+	}
+
+
+private:
+// Functions
+	// --- skipWhitespace() ---
+	void skipWhitespace()
+	{
+		m_rest.remove_prefix(std::min(m_rest.find_first_not_of(whitespace), m_rest.length()));
+	}
+
+
+// Constants
+	static constexpr std::string_view whitespace {" \t\n\v\f\r"};
+
+
+// Variables
+	std::string_view m_rest {};		// Data not read yet
+};
+
+
+
+} /* namespace aoc */
+#endif /* AOC_INPUTSCANNER_H_ */
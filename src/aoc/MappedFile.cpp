@@ -0,0 +1,172 @@
+// MappedFile.cpp
+
+//=== Include ================================================================
+#include "MappedFile.h"
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#include "BasicDefinitions.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+
+namespace aoc {
+//=== Class MappedFile =======================================================
+// --- MappedFile::~MappedFile() ---
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+
+
+// --- MappedFile::isOpen() ---
+bool MappedFile::isOpen() const
+{
+	return m_isOpen;
+}
+
+
+
+// --- MappedFile::getData() ---
+std::string_view MappedFile::getData() const
+{
+	return std::string_view {m_data, m_size};
+}
+
+
+
+// --- MappedFile::open() ---
+void MappedFile::open(const std::string& fileName)
+{
+	using namespace std::string_literals;
+
+	close();
+	if (!map(fileName)) {
+		// e.g. pipes or file systems without mmap support
+		std::ifstream file(fileName, std::ios::binary);
+		EXPECT(file.is_open(), "Could not open file: "s + fileName);
+
+		m_fallback.assign(std::istreambuf_iterator<char> {file}, std::istreambuf_iterator<char> {});
+		m_data = m_fallback.data();
+		m_size = m_fallback.size();
+	}
+	m_isOpen = true;
+}
+
+
+
+// --- MappedFile::close() ---
+void MappedFile::close()
+{
+	if (m_isMapped) {
+		unmap();
+	}
+
+	m_fallback = std::string {};
+	m_data = nullptr;
+	m_size = 0;
+	m_isOpen = false;
+	m_isMapped = false;
+}
+
+
+
+#ifdef _WIN32
+// --- MappedFile::map() ---
+// Returns false, if the file could not be mapped
+bool MappedFile::map(const std::string& fileName)
+{
+	const HANDLE file {CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+			FILE_FLAG_SEQUENTIAL_SCAN, nullptr)};
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	LARGE_INTEGER size {};
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {    // empty files can not be mapped
+		CloseHandle(file);
+		return false;
+	}
+
+	const HANDLE mapping {CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr)};
+	CloseHandle(file);    // the mapping keeps the file open
+	if (mapping == nullptr) {
+		return false;
+	}
+
+	const void* const view {MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)};
+	CloseHandle(mapping);    // the view keeps the mapping
+	if (view == nullptr) {
+		return false;
+	}
+
+	m_data = static_cast<const char*>(view);
+	m_size = static_cast<std::size_t>(size.QuadPart);
+	m_isMapped = true;
+	return true;
+}
+
+
+
+// --- MappedFile::unmap() ---
+void MappedFile::unmap()
+{
+	UnmapViewOfFile(m_data);
+}
+#else
+
+
+
+// --- MappedFile::map() ---
+// Returns false, if the file could not be mapped
+bool MappedFile::map(const std::string& fileName)
+{
+	const int file {::open(fileName.c_str(), O_RDONLY)};
+	if (file < 0) {
+		return false;
+	}
+
+	struct stat status {};
+	if (fstat(file, &status) != 0 || !S_ISREG(status.st_mode) || status.st_size == 0) {    // empty files can not be mapped
+		::close(file);
+		return false;
+	}
+
+	const auto size {static_cast<std::size_t>(status.st_size)};
+	void* const view {mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0)};
+	::close(file);    // the mapping keeps the file open
+	if (view == MAP_FAILED) {
+		return false;
+	}
+	madvise(view, size, MADV_SEQUENTIAL);
+
+	m_data = static_cast<const char*>(view);
+	m_size = size;
+	m_isMapped = true;
+	return true;
+}
+
+
+
+// --- MappedFile::unmap() ---
+void MappedFile::unmap()
+{
+	munmap(const_cast<char*>(m_data), m_size);
+}
+#endif
+
+
+
+} /* namespace aoc */
@@ -0,0 +1,62 @@
+// MappedFile.h
+/* read-only view of a whole file, mapped into memory if possible */
+
+
+
+//=== Preprocessor ===========================================================
+#ifndef AOC_MAPPEDFILE_H_
+#define AOC_MAPPEDFILE_H_
+
+
+
+//=== Include ================================================================
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+
+
+namespace aoc {
+//=== Class MappedFile =======================================================
+class MappedFile final {
+public:
+// Constructors / destructor
+	MappedFile() = default;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile(MappedFile&&) = delete;
+	~MappedFile();
+
+
+// Operators
+	MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile& operator=(MappedFile&&) = delete;
+
+
+// Getter
+	bool isOpen() const;
+	std::string_view getData() const;		// valid until the file is closed
+
+
+// Functions
+	void open(const std::string& fileName);	// throws, if the file can not be read
+	void close();
+
+
+private:
+// Functions
+	bool map(const std::string& fileName);
+	void unmap();
+
+
+// Variables
+	const char* m_data {nullptr};		// mapped file or m_fallback
+	std::size_t m_size {0};				// size of the file in bytes
+	bool m_isOpen {false};
+	bool m_isMapped {false};			// m_data has to be unmapped
+	std::string m_fallback {};			// file content, if it could not be mapped
+};
+
+
+
+} /* namespace aoc */
+#endif /* AOC_MAPPEDFILE_H_ */
@@ -0,0 +1,271 @@
+// PermutationSearch.h
+/* finds the best order of ids by a parallel depth first search with branch-and-bound */
+
+
+
+//=== Preprocessor ===========================================================
+#ifndef AOC_PERMUTATIONSEARCH_H_
+#define AOC_PERMUTATIONSEARCH_H_
+
+
+
+//=== Include ================================================================
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "BasicDefinitions.h"
+#include "ThreadPool.h"
+
+
+
+namespace aoc {
+//=== Class PermutationSearch ================================================
+/* Searches all orders of the ids 0 .. size - 1 for the lowest / highest sum of edge costs between neighbours. If isCycle,
+the last id is also a neighbour of the first one and the first id is fixed, as rotations have the same cost.
+The search tree is split by the first ids of the order into tasks of the shared thread pool. Each task extends the order
+by the ids with the best edges first, so a good order is found early. A partial order is dropped, if it can not beat the
+best order found so far by any task, even if each missing id is reached by its best edge. Needs no memory beside the
+edges, so it is used, if there are too many ids for a table of all subsets. */
+template<typename cost_type>
+class PermutationSearch final {
+public:
+// Types
+	using cost_t = cost_type;
+	using id_t = int;
+	using order_t = std::vector<id_t>;
+	using edgeCost_t = std::function<cost_t(id_t, id_t)>;
+
+	enum class EGoal {minimum, maximum};
+
+
+// Constructors / destructor
+	PermutationSearch() = delete;
+	PermutationSearch(const PermutationSearch&) = delete;
+	PermutationSearch(PermutationSearch&&) = delete;
+	~PermutationSearch() = default;
+
+
+	// --- PermutationSearch() ---
+	// edgeCost is only called once for each pair of ids
+	PermutationSearch(const std::size_t size, const edgeCost_t& edgeCost, const bool isCycle = false)
+		: m_size {size}, m_isCycle {isCycle}, m_edges(size * size, cost_t {})
+	{
+		EXPECT(size > 0, "There must be at least one id.");
+		EXPECT(size <= static_cast<std::size_t>(std::numeric_limits<id_t>::max()), "There are too many ids.");
+
+		for (std::size_t from {0}; from < m_size; ++from) {
+			for (std::size_t to {0}; to < m_size; ++to) {
+				m_edges[from * m_size + to] = edgeCost(static_cast<id_t>(from), static_cast<id_t>(to));
+			}
+		}
+	}
+
+
+// Operators
+	PermutationSearch& operator=(const PermutationSearch&) = delete;
+	PermutationSearch& operator=(PermutationSearch&&) = delete;
+
+
+// Getter
+	// --- getBestOrder() ---
+	const order_t& getBestOrder() const
+	{
+		return m_bestOrder;
+	}
+
+
+// Functions
+	// --- find() ---
+	// Returns the cost of the best order
+	cost_t find(const EGoal goal)
+	{
+		m_goal = goal;
+		m_best = (goal == EGoal::minimum) ? std::numeric_limits<cost_t>::max() : std::numeric_limits<cost_t>::lowest();
+		m_bestOrder.clear();
+		prepareEdges();
+
+		ThreadPool& pool {ThreadPool::getShared()};
+		const std::vector<order_t> prefixes {getPrefixes(pool.getSize())};
+		pool.forEach(prefixes.size(), [this, &prefixes](const std::size_t i) {
+			searchFrom(prefixes[i]);
+		});
+
+		return m_best;
+	}
+
+
+private:
+// Functions
+	// --- getEdge() ---
+	cost_t getEdge(const id_t from, const id_t to) const
+	{
+		return m_edges[static_cast<std::size_t>(from) * m_size + static_cast<std::size_t>(to)];
+	}
+
+
+	// --- isBetter() ---
+	bool isBetter(const cost_t cost, const cost_t than) const
+	{
+		return (m_goal == EGoal::minimum) ? cost < than : cost > than;
+	}
+
+
+	// --- prepareEdges() ---
+	// Sorts the next ids of each id by their edge, best first, and finds the best edge, which reaches each id
+	void prepareEdges()
+	{
+		m_nextIds.clear();
+		m_bestEdges.assign(m_size, cost_t {});
+
+		for (id_t from {0}; static_cast<std::size_t>(from) < m_size; ++from) {
+			const auto begin {m_nextIds.size()};
+			for (id_t to {0}; static_cast<std::size_t>(to) < m_size; ++to) {
+				if (to != from) {
+					m_nextIds.push_back(to);
+				}
+			}
+			std::stable_sort(m_nextIds.begin() + static_cast<std::ptrdiff_t>(begin), m_nextIds.end(),
+					[this, from](const id_t lhs, const id_t rhs) { return isBetter(getEdge(from, lhs), getEdge(from, rhs)); });
+		}
+
+		for (id_t to {0}; static_cast<std::size_t>(to) < m_size; ++to) {
+			const std::size_t index {static_cast<std::size_t>(to)};
+			bool isFirst {true};
+			for (id_t from {0}; static_cast<std::size_t>(from) < m_size; ++from) {
+				if (from != to && (isFirst || isBetter(getEdge(from, to), m_bestEdges[index]))) {
+					m_bestEdges[index] = getEdge(from, to);
+					isFirst = false;
+				}
+			}
+		}
+	}
+
+
+	// --- getPrefixes() ---
+	// First ids of the orders, one for each task. Enough for some tasks per thread to balance pruned subtrees.
+	std::vector<order_t> getPrefixes(const std::size_t threads) const
+	{
+		constexpr std::size_t tasks_per_thread {8};
+
+		std::vector<order_t> result {order_t {0}};
+		if (!m_isCycle) {
+			result.clear();
+			for (id_t id {0}; static_cast<std::size_t>(id) < m_size; ++id) {
+				result.push_back(order_t {id});
+			}
+		}
+
+		while (result.size() < threads * tasks_per_thread && result.front().size() < m_size) {
+			std::vector<order_t> longer {};
+			for (const auto& prefix : result) {
+				for (id_t id {0}; static_cast<std::size_t>(id) < m_size; ++id) {
+					if (std::find(prefix.cbegin(), prefix.cend(), id) == prefix.cend()) {
+						longer.push_back(prefix);
+						longer.back().push_back(id);
+					}
+				}
+			}
+			result = std::move(longer);
+		}
+
+		return result;
+	}
+
+
+	// --- searchFrom() ---
+	void searchFrom(const order_t& prefix)
+	{
+		order_t order(m_size, 0);
+		std::vector<bool> isUsed(m_size, false);
+		cost_t cost {};
+		cost_t missing {};		// best edges, which reach the ids behind the prefix
+
+		for (std::size_t i {0}; i < prefix.size(); ++i) {
+			order[i] = prefix[i];
+			isUsed[static_cast<std::size_t>(prefix[i])] = true;
+			if (i > 0) {
+				cost += getEdge(prefix[i - 1], prefix[i]);
+			}
+		}
+		for (std::size_t id {0}; id < m_size; ++id) {
+			if (!isUsed[id]) {
+				missing += m_bestEdges[id];
+			}
+		}
+		if (m_isCycle && m_size > 1) {
+			missing += m_bestEdges[static_cast<std::size_t>(order.front())];	// the edge, which closes the cycle
+		}
+
+		search(order, isUsed, prefix.size(), cost, missing);
+	}
+
+
+	// --- search() ---
+	// order[0, depth) is fixed, cost is the sum of its edges
+	void search(order_t& order, std::vector<bool>& isUsed, const std::size_t depth, const cost_t cost, const cost_t missing)
+	{
+		if (depth == m_size) {
+			const cost_t total {(m_isCycle && m_size > 1) ? cost + getEdge(order.back(), order.front()) : cost};
+			updateBest(order, total);
+			return;
+		}
+
+		if (!isBetter(cost + missing, m_best.load(std::memory_order_relaxed))) {
+			return;
+		}
+
+		const id_t last {order[depth - 1]};
+		const std::size_t first {static_cast<std::size_t>(last) * (m_size - 1)};
+		for (std::size_t i {first}; i < first + m_size - 1; ++i) {
+			const id_t next {m_nextIds[i]};
+			const std::size_t index {static_cast<std::size_t>(next)};
+			if (isUsed[index]) {
+				continue;
+			}
+
+			isUsed[index] = true;
+			order[depth] = next;
+			search(order, isUsed, depth + 1, cost + getEdge(last, next), missing - m_bestEdges[index]);
+			isUsed[index] = false;
+		}
+	}
+
+
+	// --- updateBest() ---
+	void updateBest(const order_t& order, const cost_t cost)
+	{
+		if (!isBetter(cost, m_best.load(std::memory_order_relaxed))) {
+			return;
+		}
+
+		const std::lock_guard<std::mutex> lock {m_mutex};
+		if (isBetter(cost, m_best.load(std::memory_order_relaxed))) {
+			m_best.store(cost, std::memory_order_relaxed);
+			m_bestOrder = order;
+		}
+	}
+
+
+// Variables
+	const std::size_t m_size;					// number of ids
+	const bool m_isCycle;						// last id is next to the first one
+	std::vector<cost_t> m_edges;				// dense matrix of the edge costs
+	std::vector<id_t> m_nextIds {};				// size - 1 other ids for each id, the best edge first
+	std::vector<cost_t> m_bestEdges {};			// best edge, which reaches each id
+
+	EGoal m_goal {EGoal::minimum};
+	std::atomic<cost_t> m_best {};				// read without lock for pruning
+	order_t m_bestOrder {};						// guarded by m_mutex during the search
+	std::mutex m_mutex {};
+};
+
+
+
+} /* namespace aoc */
+#endif /* AOC_PERMUTATIONSEARCH_H_ */
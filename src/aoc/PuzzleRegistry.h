@@ -0,0 +1,69 @@
+// PuzzleRegistry.h
+/* compile-time list of all solved puzzles, each with a factory to create its solver */
+
+
+
+//=== Preprocessor ===========================================================
+#ifndef AOC_PUZZLEREGISTRY_H_
+#define AOC_PUZZLEREGISTRY_H_
+
+
+
+//=== Include ================================================================
+#include <array>
+#include <cstddef>
+#include <memory>
+
+#include "BasicDefinitions.h"
+#include "Day00.h"
+
+
+
+namespace aoc {
+//=== Types ==================================================================
+struct SPuzzle {
+	EYears year;
+	EDays day;
+	pPuzzle (*create)();	// creates the solver, puzzles are only instantiated to be solved
+};
+
+
+
+//=== Functions ==============================================================
+// --- createPuzzle() ---
+template<typename Puzzle>
+pPuzzle createPuzzle()
+{
+	return std::make_unique<Puzzle>();
+}
+
+
+
+// --- registerPuzzle() ---
+template<typename Puzzle>
+constexpr SPuzzle registerPuzzle(const EYears year, const EDays day)
+{
+	return SPuzzle {year, day, &createPuzzle<Puzzle>};
+}
+
+
+
+// --- isOrdered() ---
+// Puzzles have to be sorted by year and day without duplicates, use it with static_assert
+template<std::size_t Size>
+constexpr bool isOrdered(const std::array<SPuzzle, Size>& puzzles)
+{
+	for (std::size_t i {1}; i < Size; ++i) {
+		const auto& prev {puzzles[i - 1]};
+		const auto& next {puzzles[i]};
+		if (prev.year > next.year || (prev.year == next.year && prev.day >= next.day)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+
+
+} /* namespace aoc */
+#endif /* AOC_PUZZLEREGISTRY_H_ */
@@ -11,10 +11,14 @@
 
 //=== Include ================================================================
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <iterator>
-#include <list>
 #include <map>
 #include <numeric>
+#include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -23,10 +27,79 @@
 
 
 namespace aoc {
+//=== Class RowView =========================================================
+/* Contiguous part of a container, e.g. a row of a Grid */
+// CHECK: if C++20 use std::span instead
+template<typename data_type>
+class RowView {
+public:
+// Types
+	using data_t = data_type;
+	using size_t = std::size_t;
+
+
+// Constructors / destructor
+	RowView() = delete;
+	RowView(const RowView&) = default;
+	RowView(RowView&&) = default;
+	~RowView() = default;
+
+
+	// --- RowView() ---
+	RowView(data_t* const first, const size_t size) : m_first {first}, m_size {size}
+	{
+		// Do nothing
+	}
+
+
+// Operators
+	RowView& operator=(const RowView&) = default;
+	RowView& operator=(RowView&&) = default;
+
+
+	// --- operator[]() ---
+	data_t& operator[](const size_t index) const
+	{
+		return m_first[index];
+	}
+
+
+// Getter
+	// --- begin() ---
+	data_t* begin() const
+	{
+		return m_first;
+	}
+
+
+	// --- end() ---
+	data_t* end() const
+	{
+		return m_first + m_size;
+	}
+
+
+	// --- size() ---
+	size_t size() const
+	{
+		return m_size;
+	}
+
+
+private:
+// Variables
+	data_t* m_first;	// First element of the view
+	size_t m_size;		// Number of elements
+};
+
+
+
 //=== Class Grid ============================================================
-/* Two dimensional static array implemented using a vector. */
+/* Two dimensional static array implemented using a vector. The data is stored row by row: x is the position inside a
+row, y is the row. Loops should iterate x in the inner loop (or use row()), so the memory is read linearly.
+Optionally the grid is surrounded by a border of default initialised elements (e.g. 0). Stencil code may then read the
+neighbours of any position without bounds checks: &grid[pos] + dy * getStride() + dx for |dx|, |dy| <= border. */
 // TODO: make dynamic, problem: need to change positions when necessary
-// CHECK: can be made compatible with bool?
 // TODO: maybe add count_if
 template<typename data_type>
 class Grid {
@@ -50,8 +123,9 @@ public:
 
 
 	// --- Grid() ---
-	Grid(const dimension_t gridWidth, const dimension_t gridHeight) :
-			m_width {gridWidth}, m_height {gridHeight}, m_data(gridWidth * gridHeight)
+	Grid(const dimension_t gridWidth, const dimension_t gridHeight, const dimension_t border = 0) :
+			m_width {gridWidth}, m_height {gridHeight}, m_border {border}, m_stride {gridWidth + 2 * border},
+			m_data(m_stride * (static_cast<std::size_t>(gridHeight) + 2 * border))
 	{
 		EXPECT(gridWidth != 0 && gridHeight != 0, "Can not create a grid with at least one dimension = 0.");
 	}
@@ -65,7 +139,14 @@ public:
 	// --- operator[]() ---
 	data_t& operator[](const Position pos)
 	{
-		return m_data[pos.x * m_width + pos.y];
+		return m_data[index(pos)];
+	}
+
+
+	// --- operator[]() ---
+	const data_t& operator[](const Position pos) const
+	{
+		return m_data[index(pos)];
 	}
 
 
@@ -77,31 +158,75 @@ public:
 	}
 
 
-	// --- getHeight() ---
+	// --- getWidth() ---
 	dimension_t getWidth() const
 	{
 		return m_width;
 	}
 
 
+	// --- getBorder() ---
+	dimension_t getBorder() const
+	{
+		return m_border;
+	}
+
+
+	// --- getStride() ---
+	// Distance between the first elements of two following rows (including the border)
+	std::size_t getStride() const
+	{
+		return m_stride;
+	}
+
+
 // Functions
 	// --- at() ---
 	data_t& at(const Position pos)
 	{
 		EXPECT((pos.x < m_width) && (pos.y < m_height), "Grid out of range.");
-		return m_data[pos.x * m_width + pos.y];
+		return m_data[index(pos)];
+	}
+
+
+	// --- at() ---
+	const data_t& at(const Position pos) const
+	{
+		EXPECT((pos.x < m_width) && (pos.y < m_height), "Grid out of range.");
+		return m_data[index(pos)];
+	}
+
+
+	// --- row() ---
+	// All elements of row y, stored contiguously
+	RowView<data_t> row(const dimension_t y)
+	{
+		return RowView<data_t> {&m_data[index(Position {0, y})], m_width};
+	}
+
+
+	// --- row() ---
+	RowView<const data_t> row(const dimension_t y) const
+	{
+		return RowView<const data_t> {&m_data[index(Position {0, y})], m_width};
 	}
 
 
 	// --- accumulateData() ---
+	// Sum of all elements, except the border
 	accumulate_t accumulateData() const
 	{
-		const auto start_data {static_cast<accumulate_t>(m_data[0])};    // prevents accumulate from overflow for small types (e.g.: data_t = signed char)
-		return std::accumulate(std::next(m_data.cbegin()), m_data.cend(), start_data);
+		accumulate_t result {0};    // prevents accumulate from overflow for small types (e.g.: data_t = signed char)
+		for (dimension_t y {0}; y < m_height; ++y) {
+			const auto data {row(y)};
+			result = std::accumulate(data.begin(), data.end(), result);
+		}
+		return result;
 	}
 
 
 	// --- begin() ---
+	// begin() to end() includes the border
 	auto begin()
 	{
 		return m_data.begin();
@@ -115,96 +240,391 @@ public:
 	}
 
 
+	// --- cbegin() ---
+	auto cbegin() const
+	{
+		return m_data.cbegin();
+	}
+
+
+	// --- cend() ---
+	auto cend() const
+	{
+		return m_data.cend();
+	}
+
+
 private:
+// Functions
+	// --- index() ---
+	std::size_t index(const Position pos) const
+	{
+		return (static_cast<std::size_t>(pos.y) + m_border) * m_stride + pos.x + m_border;
+	}
+
+
 // Variables
 	dimension_t m_width;		// Width of the data array
 	dimension_t m_height;		// Height of the data array
+	dimension_t m_border;		// Elements around the data array on each side
+	std::size_t m_stride;		// Width including the border
 	std::vector<data_t> m_data;		// Data container
 };
 
 
 
-//=== Class DoubleKeyMap =====================================================
-template<typename key_type, typename value_type>
-class DoubleKeyMap {
+//=== Class Grid<bool> ======================================================
+/* Two dimensional static array of bits. Each row is stored in 64 bit words, so whole ranges of a row can be changed and
+counted a word at a time. x is the position inside a row, y is the row. Unused bits at the end of a row are always 0. */
+template<>
+class Grid<bool> {
 public:
 // Types
-	using key_t = key_type;
-	using keyPair_t = std::pair<key_type, key_type>;
-	using value_t = value_type;
+	using data_t = bool;
+	using dimension_t = unsigned int;
+	using accumulate_t = long long;
+	using word_t = std::uint64_t;
+
+	struct Position {
+		dimension_t x {0};
+		dimension_t y {0};
+	};
+
+
+	// Like std::vector<bool>::reference: a single bit can not be referenced directly
+	class Reference {
+	public:
+	// Constructors / destructor
+		Reference() = delete;
+		Reference(const Reference&) = default;
+		Reference(Reference&&) = default;
+		~Reference() = default;
+
+		Reference(word_t& word, const word_t mask) : m_word {word}, m_mask {mask}
+		{
+			// Do nothing
+		}
+
+
+	// Operators
+		// --- operator=() ---
+		Reference& operator=(const bool value)
+		{
+			m_word = value ? (m_word | m_mask) : (m_word & ~m_mask);
+			return *this;
+		}
+
+
+		// --- operator=() ---
+		Reference& operator=(const Reference& other)
+		{
+			return operator=(static_cast<bool>(other));
+		}
+
+
+		// --- operator bool() ---
+		operator bool() const
+		{
+			return (m_word & m_mask) != 0;
+		}
+
+
+	// Functions
+		// --- flip() ---
+		void flip()
+		{
+			m_word ^= m_mask;
+		}
+
+
+	private:
+	// Variables
+		word_t& m_word;		// Word containing the bit
+		const word_t m_mask;	// Only the referenced bit is set
+	};
+
+
+// Constructors / destructor
+	Grid() = delete;
+	Grid(const Grid&) = default;
+	Grid(Grid&&) = default;
+	virtual ~Grid() = default;
+
+
+	// --- Grid() ---
+	Grid(const dimension_t gridWidth, const dimension_t gridHeight) :
+			m_width {gridWidth}, m_height {gridHeight}, m_wordsPerRow {(gridWidth + word_bits - 1) / word_bits},
+			m_data(static_cast<std::size_t>(m_wordsPerRow) * gridHeight, 0)
+	{
+		EXPECT(gridWidth != 0 && gridHeight != 0, "Can not create a grid with at least one dimension = 0.");
+	}
+
+
+// Operators
+	Grid& operator=(const Grid& other) = default;
+	Grid& operator=(Grid&& other) = default;
+
+
+	// --- operator[]() ---
+	Reference operator[](const Position pos)
+	{
+		return Reference {m_data[wordIndex(pos)], bitMask(pos.x)};
+	}
+
+
+	// --- operator[]() ---
+	bool operator[](const Position pos) const
+	{
+		return (m_data[wordIndex(pos)] & bitMask(pos.x)) != 0;
+	}
+
+
+// Getter
+	// --- getHeight() ---
+	dimension_t getHeight() const
+	{
+		return m_height;
+	}
+
+
+	// --- getWidth() ---
+	dimension_t getWidth() const
+	{
+		return m_width;
+	}
+
+
+	// --- getStride() ---
+	// Distance between the first words of two following rows
+	std::size_t getStride() const
+	{
+		return m_wordsPerRow;
+	}
 
 
 // Functions
-	// --- insert() ---
-	void insert(const keyPair_t& key, const value_t& value)
+	// --- at() ---
+	Reference at(const Position pos)
 	{
-		m_mapData.insert(std::make_pair(key, value));
+		EXPECT((pos.x < m_width) && (pos.y < m_height), "Grid out of range.");
+		return operator[](pos);
 	}
 
 
-	// --- find() ---
-	auto find(const keyPair_t& key) const
+	// --- accumulateData() ---
+	// Number of set bits
+	accumulate_t accumulateData() const
 	{
-		if (m_mapData.find(key) != m_mapData.cend()) {
-			return m_mapData.at(key);
-		} else {
-			// key is const, so we can not directly swap(key.first, key.second)
-			const keyPair_t swapped_key {std::make_pair(key.second, key.first)};
-			return m_mapData.at(swapped_key);
+		accumulate_t result {0};
+		for (const word_t word : m_data) {
+			result += popcount(word);
 		}
+		return result;
+	}
+
+
+	// --- row() ---
+	// All words of row y, bit x of the row is bit (x % 64) of word (x / 64)
+	RowView<word_t> row(const dimension_t y)
+	{
+		return RowView<word_t> {&m_data[wordIndex(Position {0, y})], m_wordsPerRow};
+	}
+
+
+	// --- row() ---
+	RowView<const word_t> row(const dimension_t y) const
+	{
+		return RowView<const word_t> {&m_data[wordIndex(Position {0, y})], m_wordsPerRow};
+	}
+
+
+	// --- setRow() ---
+	// Sets all bits from first to last (inclusive) of row y
+	void setRow(const dimension_t y, const dimension_t first, const dimension_t last)
+	{
+		changeRow(y, first, last, [](word_t& word, const word_t mask) { word |= mask; });
+	}
+
+
+	// --- clearRow() ---
+	// Clears all bits from first to last (inclusive) of row y
+	void clearRow(const dimension_t y, const dimension_t first, const dimension_t last)
+	{
+		changeRow(y, first, last, [](word_t& word, const word_t mask) { word &= ~mask; });
+	}
+
+
+	// --- flipRow() ---
+	// Flips all bits from first to last (inclusive) of row y
+	void flipRow(const dimension_t y, const dimension_t first, const dimension_t last)
+	{
+		changeRow(y, first, last, [](word_t& word, const word_t mask) { word ^= mask; });
 	}
 
 
 private:
+// Constants
+	static constexpr dimension_t word_bits {64};
+
+
+// Functions
+	// --- popcount() ---
+	// CHECK: if C++20 use std::popcount() instead
+	static int popcount(const word_t word)
+	{
+		return __builtin_popcountll(word);
+	}
+
+
+	// --- bitMask() ---
+	static word_t bitMask(const dimension_t x)
+	{
+		return word_t {1} << (x % word_bits);
+	}
+
+
+	// --- wordIndex() ---
+	std::size_t wordIndex(const Position pos) const
+	{
+		return static_cast<std::size_t>(pos.y) * m_wordsPerRow + pos.x / word_bits;
+	}
+
+
+	// --- changeRow() ---
+	// Calls func(word, mask) for each word of the range, mask contains the bits of the range inside the word
+	template<typename Func>
+	void changeRow(const dimension_t y, const dimension_t first, const dimension_t last, Func func)
+	{
+		EXPECT((first <= last) && (last < m_width) && (y < m_height), "Grid out of range.");
+
+		const std::size_t first_word {wordIndex(Position {first, y})};
+		const std::size_t last_word {wordIndex(Position {last, y})};
+		const word_t first_mask {~word_t {0} << (first % word_bits)};		// first bit and all following
+		const word_t last_mask {~word_t {0} >> (word_bits - 1 - last % word_bits)};	// last bit and all preceding
+
+		if (first_word == last_word) {
+			func(m_data[first_word], first_mask & last_mask);
+			return;
+		}
+
+		func(m_data[first_word], first_mask);
+		for (std::size_t i {first_word + 1}; i < last_word; ++i) {
+			func(m_data[i], ~word_t {0});
+		}
+		func(m_data[last_word], last_mask);
+	}
+
+
 // Variables
-	std::map<keyPair_t, value_t> m_mapData {};
+	dimension_t m_width;			// Width of the data array (bits per row)
+	dimension_t m_height;			// Height of the data array (rows)
+	dimension_t m_wordsPerRow;		// Each row starts with a new word
+	std::vector<word_t> m_data;		// Data container
 };
 
 
 
-//=== Class DoubleKeyMap =====================================================
-template<typename data_type>
-class UniqueList {
+//=== Class WeightMatrix =====================================================
+/* Weights between named nodes, e.g. distances between locations. Each name gets a dense id, so a weight is found
+by an array lookup. If symmetric, setting the weight from a to b also sets the one from b to a.
+Weights, which were never set, are the default weight. */
+template<typename weight_type>
+class WeightMatrix {
 public:
 // Types
-	using data_t = data_type;
+	using weight_t = weight_type;
+	using id_t = std::size_t;
 
 
-// Functions
-	// --- addData() ---
-	void addData(const data_t& data)
+// Constructors / destructor
+	// --- WeightMatrix() ---
+	explicit WeightMatrix(const bool isSymmetric, const weight_t defaultWeight = weight_t {})
+		: m_isSymmetric {isSymmetric}, m_default {defaultWeight}
 	{
-		m_listData.push_front(data);
-		m_listData.sort();    // Need to sort, to make unique. Also a sorted list is required to loop through 'all' permutations
-		m_listData.unique();
 	}
 
 
-	// --- nextPermutation() ---
-	auto nextPermutation(const std::ptrdiff_t offset = 0)
+// Operators
+	// --- operator() ---
+	weight_t operator()(const id_t from, const id_t to) const
 	{
-		return std::next_permutation(std::next(m_listData.begin(), offset), m_listData.end());
+		return m_data[from * m_stride + to];
 	}
 
 
 // Getter
-	// --- cbegin() ---
-	auto cbegin() const
+	// --- size() ---
+	std::size_t size() const
 	{
-		return m_listData.cbegin();
+		return m_ids.size();
 	}
 
 
-	// --- cend() ---
-	auto cend() const
+// Functions
+	// --- addName() ---
+	// Returns the id of name, a new name gets the next free id
+	id_t addName(std::string_view name)
+	{
+		const auto found {m_ids.find(name)};
+		if (found != m_ids.cend()) {
+			return found->second;
+		}
+
+		const id_t result {m_ids.size()};
+		if (result == m_stride) {
+			grow();
+		}
+		m_ids.emplace(name, result);
+		return result;
+	}
+
+
+	// --- setWeight() ---
+	void setWeight(const id_t from, const id_t to, const weight_t weight)
+	{
+		EXPECT(from < size() && to < size(), "Id out of bounds.");
+
+		m_data[from * m_stride + to] = weight;
+		if (m_isSymmetric) {
+			m_data[to * m_stride + from] = weight;
+		}
+	}
+
+
+	// --- setWeight() ---
+	// Adds the names, if necessary
+	void setWeight(std::string_view from, std::string_view to, const weight_t weight)
 	{
-		return m_listData.cend();
+		const auto fromId {addName(from)};
+		setWeight(fromId, addName(to), weight);
 	}
 
 
 private:
+// Functions
+	// --- grow() ---
+	// Doubles the capacity, so adding n names only copies O(n^2) weights in total
+	void grow()
+	{
+		const std::size_t stride {std::max(m_stride * 2, std::size_t {8})};
+		std::vector<weight_t> data(stride * stride, m_default);
+
+		for (std::size_t from {0}; from < m_stride; ++from) {
+			std::copy_n(std::next(m_data.cbegin(), static_cast<std::ptrdiff_t>(from * m_stride)), m_stride,
+					std::next(data.begin(), static_cast<std::ptrdiff_t>(from * stride)));
+		}
+
+		m_data = std::move(data);
+		m_stride = stride;
+	}
+
+
 // Variables
-	std::list<data_t> m_listData {};
+	bool m_isSymmetric;								// weight from a to b is always the one from b to a
+	weight_t m_default;								// weight, if it was never set
+	std::size_t m_stride {0};						// capacity of names, length of a row of m_data
+	std::vector<weight_t> m_data {};				// row major, weight from a to b is at a * m_stride + b
+	std::map<std::string, id_t, std::less<> > m_ids {};	// id of each name, std::less<> allows to find a string_view
 };
 
 
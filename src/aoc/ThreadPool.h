@@ -0,0 +1,241 @@
+// ThreadPool.h
+/* fixed number of worker threads to execute tasks in parallel */
+
+
+
+//=== Preprocessor ===========================================================
+#ifndef AOC_THREADPOOL_H_
+#define AOC_THREADPOOL_H_
+
+
+
+//=== Include ================================================================
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+
+namespace aoc {
+//=== Class ThreadPool =======================================================
+/* small class, so definition is at header
+Puzzles should use getShared(), so nested parallel code (e.g. a puzzle solved by a worker) does not create more threads
+than there are cores. */
+class ThreadPool final {
+public:
+// Types
+	using size_t = std::vector<std::thread>::size_type;
+
+
+// Constructors / destructor
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool(ThreadPool&&) = delete;
+
+
+	// --- ThreadPool() ---
+	explicit ThreadPool(const size_t numThreads = getDefaultThreads())
+	{
+		m_workers.reserve(numThreads);
+		for (size_t i {0}; i < numThreads; ++i) {
+			m_workers.emplace_back([this](){ work(); });
+		}
+	}
+
+
+	// --- ~ThreadPool() ---
+	// Finishes all queued tasks before returning
+	~ThreadPool()
+	{
+		{
+			const std::lock_guard<std::mutex> lock {m_mutex};
+			m_stop = true;
+		}
+		m_condition.notify_all();
+
+		for (auto& worker : m_workers) {
+			worker.join();
+		}
+	}
+
+
+// Operators
+	ThreadPool& operator=(const ThreadPool&) = delete;
+	ThreadPool& operator=(ThreadPool&&) = delete;
+
+
+// Getter
+	// --- getDefaultThreads() ---
+	static size_t getDefaultThreads()
+	{
+		const auto result {std::thread::hardware_concurrency()};
+		return result > 0 ? result : 1;    // hardware_concurrency() returns 0, if it is not computable
+	}
+
+
+	// --- getSize() ---
+	size_t getSize() const
+	{
+		return m_workers.size();
+	}
+
+
+	// --- getShared() ---
+	// Pool of all puzzles, created by the first call
+	static ThreadPool& getShared()
+	{
+		static ThreadPool pool {};
+		return pool;
+	}
+
+
+// Functions
+	// --- addTask() ---
+	// Queues func to be called by the next free worker, exceptions are passed to the returned future
+	template<typename Func>
+	auto addTask(Func&& func)
+	{
+		using result_t = std::invoke_result_t<std::decay_t<Func> >;
+
+		// std::function needs a copyable object, but std::packaged_task can only be moved
+		const auto task {std::make_shared<std::packaged_task<result_t()> >(std::forward<Func>(func))};
+		std::future<result_t> result {task->get_future()};
+
+		{
+			const std::lock_guard<std::mutex> lock {m_mutex};
+			m_tasks.emplace([task](){ (*task)(); });
+		}
+		m_condition.notify_one();
+
+		return result;
+	}
+
+
+	// --- forEach() ---
+	// Calls func(i) for each i in [0, count), started in ascending order, and returns, when all calls are done.
+	// The calling thread takes part, so it never waits for queued tasks only, even if it is a worker of this pool.
+	// The first exception of func is rethrown.
+	template<typename Func>
+	void forEach(const std::size_t count, const Func& func)
+	{
+		// Helpers may start after forEach() returned, then they only find no index left. So the state must be shared,
+		// but func is only called for claimed indices, which are all done before forEach() returns.
+		struct SState {
+			std::atomic<std::size_t> next {0};
+			std::atomic<std::size_t> done {0};
+			std::exception_ptr error {};			// guarded by mutex
+			std::mutex mutex {};
+			std::condition_variable condition {};
+		};
+		const auto state {std::make_shared<SState>()};
+
+		const auto work = [state, count, &func]() {
+			for (std::size_t i {state->next.fetch_add(1)}; i < count; i = state->next.fetch_add(1)) {
+				try {
+					func(i);
+				} catch (...) {
+					const std::lock_guard<std::mutex> lock {state->mutex};
+					if (!state->error) {
+						state->error = std::current_exception();
+					}
+				}
+
+				if (state->done.fetch_add(1) + 1 == count) {
+					const std::lock_guard<std::mutex> lock {state->mutex};
+					state->condition.notify_all();
+				}
+			}
+		};
+
+		const std::size_t helpers {std::min<std::size_t>(getSize(), count) - (count > 0 ? 1 : 0)};
+		{
+			const std::lock_guard<std::mutex> lock {m_mutex};
+			for (std::size_t i {0}; i < helpers; ++i) {
+				m_tasks.emplace(work);
+			}
+		}
+		m_condition.notify_all();
+
+		work();
+
+		std::unique_lock<std::mutex> lock {state->mutex};
+		state->condition.wait(lock, [&state, count](){ return state->done.load() == count; });
+		if (state->error) {
+			std::rethrow_exception(state->error);
+		}
+	}
+
+
+	// --- findLowest() ---
+	// Returns the lowest value in [first, last], which search(chunkFirst, chunkLast) finds in a chunk of the range, or
+	// notFound (> last). Chunks are started in ascending order and skipped, if they start behind a value found already.
+	template<typename T, typename Search>
+	T findLowest(const T first, const T last, const T chunkSize, const T notFound, const Search& search)
+	{
+		std::atomic<T> result {notFound};
+		const auto chunks {static_cast<std::size_t>((last - first) / chunkSize) + 1};
+
+		forEach(chunks, [&](const std::size_t chunk) {
+			const auto chunkFirst {static_cast<T>(first + static_cast<T>(chunk) * chunkSize)};
+			if (chunkFirst >= result.load()) {
+				return;
+			}
+
+			const T chunkLast {(last - chunkFirst < chunkSize) ? last : static_cast<T>(chunkFirst + (chunkSize - 1))};
+			const T found {search(chunkFirst, chunkLast)};
+			T expected {result.load()};
+			while ((found < expected) && !result.compare_exchange_weak(expected, found)) {
+				// Try again, another task changed the result
+			}
+		});
+
+		return result;
+	}
+
+
+private:
+// Functions
+	// --- work() ---
+	void work()
+	{
+		while (true) {
+			std::function<void()> task {};
+
+			{
+				std::unique_lock<std::mutex> lock {m_mutex};
+				m_condition.wait(lock, [this](){ return m_stop || !m_tasks.empty(); });
+				if (m_tasks.empty()) {    // only empty, if m_stop is set
+					return;
+				}
+
+				task = std::move(m_tasks.front());
+				m_tasks.pop();
+			}
+
+			task();
+		}
+	}
+
+
+// Variables
+	std::vector<std::thread> m_workers {};				// Threads executing the tasks
+	std::queue<std::function<void()> > m_tasks {};		// Tasks not yet started
+	std::mutex m_mutex {};								// Guards m_tasks and m_stop
+	std::condition_variable m_condition {};				// Wakes workers, if there is a new task or the pool is destroyed
+	bool m_stop {false};								// Set, if the pool is destroyed
+};
+
+
+
+} /* namespace aoc */
+#endif /* AOC_THREADPOOL_H_ */
@@ -36,6 +36,7 @@ documentation and/or software.
 #include "md5.h"
 
 /* system implementation headers */
+#include <cstdint>
 #include <cstdio>
 
 
@@ -109,9 +110,9 @@ MD5::MD5() {
 //////////////////////////////////////////////
 
 // nifty shortcut ctor, compute MD5 for string and finalize it right away
-MD5::MD5(const std::string& text) {
+MD5::MD5(std::string_view text) {
 	init();
-	update(text.c_str(), text.length());
+	update(text);
 	finalize();
 }
 
@@ -290,6 +291,13 @@ void MD5::update(const char input[], size_type length) {
 
 //////////////////////////////
 
+// for convenience provide a version with string_view, does not copy the text
+void MD5::update(std::string_view text) {
+	update(text.data(), static_cast<size_type>(text.length()));
+}
+
+//////////////////////////////
+
 // MD5 finalization. Ends an MD5 message-digest operation, writing the
 // the message digest and zeroizing the context.
 MD5& MD5::finalize() {
@@ -342,16 +350,253 @@ std::string MD5::hexdigest() const {
 
 //////////////////////////////
 
+// copy digest as 16 raw bytes to result, avoids the string conversion of hexdigest()
+bool MD5::rawdigest(digest_type& result) const {
+	if (!finalized)
+		return false;
+
+	std::memcpy(result.data(), digest, result.size());
+	return true;
+}
+
+//////////////////////////////
+
 std::ostream& operator<<(std::ostream& out, MD5 md5) {
 	return out << md5.hexdigest();
 }
 
 //////////////////////////////
 
-std::string md5(const std::string str) {
+std::string md5(std::string_view str) {
 	MD5 md5 = MD5(str);
 
 	return md5.hexdigest();
 }
 
+//////////////////////////////
+
+void md5(std::string_view str, MD5::digest_type& result) {
+	MD5(str).rawdigest(result);
+}
+
+//////////////////////////////
+// Multi lane MD5
+//
+// Hashes several independent messages at once, each message uses one lane of
+// a SIMD register. Only messages fitting into a single block (at most 55
+// bytes) are supported by the SIMD kernels, so no buffering is needed.
+// The kernel is written with GCC vector extensions and compiled for
+// SSE2 (4 lanes), AVX2 (8 lanes) and AVX-512 (16 lanes). The widest one the
+// cpu supports is chosen at runtime, otherwise the scalar MD5 class is used.
+
+namespace {
+
+typedef std::uint32_t lane_word;
+
+enum { max_lane_length = 55 }; // longest message fitting into one block with padding
+enum { max_lanes = 16 };
+
+// sine constants and message word order of all 64 steps
+const lane_word lane_ac[64] = {
+  0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+  0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+  0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+  0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+  0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+  0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+  0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+  0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+};
+const unsigned int lane_shift[64] = {
+  S11, S12, S13, S14, S11, S12, S13, S14, S11, S12, S13, S14, S11, S12, S13, S14,
+  S21, S22, S23, S24, S21, S22, S23, S24, S21, S22, S23, S24, S21, S22, S23, S24,
+  S31, S32, S33, S34, S31, S32, S33, S34, S31, S32, S33, S34, S31, S32, S33, S34,
+  S41, S42, S43, S44, S41, S42, S43, S44, S41, S42, S43, S44, S41, S42, S43, S44
+};
+const unsigned int lane_index[64] = {
+  0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+  1, 6, 11, 0, 5, 10, 15, 4, 9, 14, 3, 8, 13, 2, 7, 12,
+  5, 8, 11, 14, 1, 4, 7, 10, 13, 0, 3, 6, 9, 12, 15, 2,
+  0, 7, 14, 5, 12, 3, 10, 1, 8, 15, 6, 13, 4, 11, 2, 9
+};
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MD5_LANES_X86 1
+#else
+#define MD5_LANES_X86 0
+#endif
+
+#if MD5_LANES_X86
+// init: state of all lanes before the block (e.g. after a common prefix)
+// block: 16 message words per lane, word w of lane l at block[w * lanes + l]
+// digests: 4 state words per lane, word w of lane l at digests[w * lanes + l]
+// always_inline, so the kernel is compiled with the target of the caller
+template<typename vec, unsigned int lanes>
+inline __attribute__((always_inline)) void transform_lanes(const lane_word init[4], const lane_word* block, lane_word* digests) {
+	vec x[16];
+	for (unsigned int i = 0; i < 16; i++)
+		std::memcpy(&x[i], &block[i * lanes], sizeof(vec));
+
+	const vec init_a = vec{} + init[0];
+	const vec init_b = vec{} + init[1];
+	const vec init_c = vec{} + init[2];
+	const vec init_d = vec{} + init[3];
+	vec a = init_a, b = init_b, c = init_c, d = init_d;
+
+#define MD5_LANE_STEP(f) \
+	{ \
+		const vec sum = a + (f) + x[lane_index[i]] + lane_ac[i]; \
+		const vec rotated = (sum << lane_shift[i]) | (sum >> (32 - lane_shift[i])); \
+		a = d; \
+		d = c; \
+		c = b; \
+		b = b + rotated; \
+	}
+
+#pragma GCC unroll 16
+	for (unsigned int i = 0; i < 16; i++)
+		MD5_LANE_STEP((b & c) | (~b & d))
+#pragma GCC unroll 16
+	for (unsigned int i = 16; i < 32; i++)
+		MD5_LANE_STEP((b & d) | (c & ~d))
+#pragma GCC unroll 16
+	for (unsigned int i = 32; i < 48; i++)
+		MD5_LANE_STEP(b ^ c ^ d)
+#pragma GCC unroll 16
+	for (unsigned int i = 48; i < 64; i++)
+		MD5_LANE_STEP(c ^ (b | ~d))
+
+#undef MD5_LANE_STEP
+
+	a += init_a;
+	b += init_b;
+	c += init_c;
+	d += init_d;
+	std::memcpy(&digests[0 * lanes], &a, sizeof(vec));
+	std::memcpy(&digests[1 * lanes], &b, sizeof(vec));
+	std::memcpy(&digests[2 * lanes], &c, sizeof(vec));
+	std::memcpy(&digests[3 * lanes], &d, sizeof(vec));
+}
+
+typedef lane_word vec4 __attribute__((vector_size(16)));
+typedef lane_word vec8 __attribute__((vector_size(32)));
+typedef lane_word vec16 __attribute__((vector_size(64)));
+
+__attribute__((target("sse2")))
+void transform_sse2(const lane_word init[4], const lane_word* block, lane_word* digests) {
+	transform_lanes<vec4, 4>(init, block, digests);
+}
+
+__attribute__((target("avx2")))
+void transform_avx2(const lane_word init[4], const lane_word* block, lane_word* digests) {
+	transform_lanes<vec8, 8>(init, block, digests);
+}
+
+__attribute__((target("avx512f")))
+void transform_avx512(const lane_word init[4], const lane_word* block, lane_word* digests) {
+	transform_lanes<vec16, 16>(init, block, digests);
+}
+#endif // MD5_LANES_X86
+
+typedef void (*transform_function)(const lane_word init[4], const lane_word* block, lane_word* digests);
+
+struct lane_kernel {
+	transform_function transform;
+	unsigned int lanes;
+};
+
+// choose the widest kernel supported by the cpu
+lane_kernel select_lane_kernel() {
+#if MD5_LANES_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f"))
+		return lane_kernel{transform_avx512, 16};
+	if (__builtin_cpu_supports("avx2"))
+		return lane_kernel{transform_avx2, 8};
+	if (__builtin_cpu_supports("sse2"))
+		return lane_kernel{transform_sse2, 4};
+#endif // MD5_LANES_X86
+	return lane_kernel{nullptr, 1};
+}
+
+const lane_kernel& get_lane_kernel() {
+	static const lane_kernel kernel = select_lane_kernel();
+	return kernel;
+}
+
+} // namespace
+
+//////////////////////////////
+
+unsigned int md5_lanes() {
+	return get_lane_kernel().lanes;
+}
+
+//////////////////////////////
+
+void md5_multi(const std::string_view messages[], MD5::digest_type digests[], unsigned int count) {
+	md5_multi(MD5(), messages, digests, count);
+}
+
+//////////////////////////////
+
+void md5_multi(const MD5& prefix, const std::string_view suffixes[], MD5::digest_type digests[], unsigned int count) {
+	const lane_kernel& kernel = get_lane_kernel();
+	const unsigned int lanes = kernel.lanes;
+
+	// bytes of the prefix, that did not fill a complete block yet
+	const MD5::size_type buffered = prefix.count[0] / 8 % MD5::blocksize;
+
+	for (unsigned int first = 0; first < count; first += lanes) {
+		const unsigned int used = (count - first < lanes) ? count - first : lanes;
+
+		bool fits = kernel.transform != nullptr;
+		for (unsigned int l = 0; l < used; l++)
+			fits = fits && buffered + suffixes[first + l].length() <= max_lane_length;
+
+		// scalar fallback: no SIMD support or a message does not fit into one block
+		if (!fits) {
+			for (unsigned int l = 0; l < used; l++) {
+				MD5 md5 = prefix;
+				md5.update(suffixes[first + l]);
+				md5.finalize().rawdigest(digests[first + l]);
+			}
+			continue;
+		}
+
+		// pad the rest of each message to a full block and transpose it, unused lanes are ignored
+		lane_word block[16 * max_lanes] = {};
+		for (unsigned int l = 0; l < used; l++) {
+			const std::string_view suffix = suffixes[first + l];
+			const MD5::size_type length = buffered + static_cast<MD5::size_type>(suffix.length());
+
+			unsigned char padded[64] = {};
+			std::memcpy(padded, prefix.buffer, buffered);
+			std::memcpy(padded + buffered, suffix.data(), suffix.length());
+			padded[length] = 0x80;
+
+			// 64 bit length of the whole message in bits
+			MD5::uint4 bits[2] = {prefix.count[0] + static_cast<MD5::uint4>(suffix.length()) * 8, prefix.count[1]};
+			if (bits[0] < prefix.count[0])
+				bits[1]++;
+			MD5::encode(padded + 56, bits, 8);
+
+			lane_word words[16];
+			MD5::decode(words, padded, 64);
+			for (unsigned int w = 0; w < 16; w++)
+				block[w * lanes + l] = words[w];
+		}
+
+		lane_word state[4 * max_lanes];
+		kernel.transform(prefix.state, block, state);
+
+		for (unsigned int l = 0; l < used; l++) {
+			lane_word words[4] = {state[0 * lanes + l], state[1 * lanes + l], state[2 * lanes + l], state[3 * lanes + l]};
+			MD5::encode(digests[first + l].data(), words, 16);
+		}
+	}
+}
+
+#undef MD5_LANES_X86
+
 #undef _CRT_SECURE_NO_DEPRECATE
\ No newline at end of file
@@ -35,8 +35,12 @@ documentation and/or software.
 #ifndef BZF_MD5_H
 #define BZF_MD5_H
 
+#include <array>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
+#include <string>
+#include <string_view>
 
 
 // a small class for calculating MD5 hashes of strings or byte arrays
@@ -44,22 +48,30 @@ documentation and/or software.
 //
 // usage: 1) feed it blocks of uchars with update()
 //      2) finalize()
-//      3) get hexdigest() string
+//      3) get hexdigest() string or rawdigest() bytes
 //      or
-//      MD5(std::string).hexdigest()
+//      MD5(std::string_view).hexdigest()
+//
+// hashing many messages with a common prefix: feed the prefix with
+// update() once, then copy the object for each message (the copy keeps the
+// state after the prefix) and only update() the copy with the suffix
 //
 // assumes that char is 8 bit and int is 32 bit
 class MD5 {
 public:
 	typedef unsigned int size_type; // must be 32bit
+	typedef std::array<std::uint8_t, 16> digest_type;
 
 	MD5();
-	MD5(const std::string& text);
+	MD5(std::string_view text);
 	void update(const unsigned char* buf, size_type length);
 	void update(const char* buf, size_type length);
+	void update(std::string_view text);
 	MD5& finalize();
 	std::string hexdigest() const;
+	bool rawdigest(digest_type& result) const; // false if not finalized
 	friend std::ostream& operator<<(std::ostream&, MD5 md5);
+	friend void md5_multi(const MD5& prefix, const std::string_view suffixes[], digest_type digests[], unsigned int count);
 
 private:
 	void init();
@@ -89,6 +101,17 @@ private:
 	static inline void II(uint4& a, uint4 b, uint4 c, uint4 d, uint4 x, uint4 s, uint4 ac);
 };
 
-std::string md5(const std::string str);
+std::string md5(std::string_view str);
+void md5(std::string_view str, MD5::digest_type& result); // does not allocate
+
+// multi lane MD5: hashes count independent messages at once, using the
+// widest SIMD registers of the cpu (SSE2, AVX2 or AVX-512, scalar fallback)
+// messages fitting into a single block (at most 55 bytes after the last
+// complete block of the prefix) use the SIMD kernel, longer ones are hashed
+// one by one; writes the raw digest of each message to digests
+unsigned int md5_lanes(); // number of messages hashed at once
+void md5_multi(const std::string_view messages[], MD5::digest_type digests[], unsigned int count);
+// hashes prefix + suffixes[i], prefix must not be finalized
+void md5_multi(const MD5& prefix, const std::string_view suffixes[], MD5::digest_type digests[], unsigned int count);
 
 #endif
\ No newline at end of file
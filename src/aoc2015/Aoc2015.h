@@ -10,13 +10,66 @@
 
 
 //=== Include ================================================================
+#include <array>
+
 #include "../aoc/BasicDefinitions.h"
+#include "../aoc/PuzzleRegistry.h"
+
+#include "Day01.h"
+#include "Day02.h"
+#include "Day03.h"
+#include "Day04.h"
+#include "Day05.h"
+#include "Day06.h"
+#include "Day07.h"
+#include "Day08.h"
+#include "Day09.h"
+#include "Day10.h"
+#include "Day11.h"
+#include "Day12.h"
+#include "Day13.h"
+#include "Day14.h"
+#include "Day15.h"
+#include "Day16.h"
+#include "Day17.h"
+#include "Day18.h"
+#include "Day19.h"
+#include "Day20.h"
+#include "Day21.h"
+#include "Day23.h"
 
 
 
 namespace aoc2015 {
-//=== Function ===============================================================
-void solvePuzzle2015(const aoc::EDays day);
+//=== Constants ==============================================================
+constexpr aoc::EYears year_2015 {aoc::EYears::Year2015};
+
+// To add a puzzle, include its header and add it here
+constexpr std::array puzzles_2015 {
+	aoc::registerPuzzle<Day01>(year_2015, aoc::EDays::Day01),
+	aoc::registerPuzzle<Day02>(year_2015, aoc::EDays::Day02),
+	aoc::registerPuzzle<Day03>(year_2015, aoc::EDays::Day03),
+	aoc::registerPuzzle<Day04>(year_2015, aoc::EDays::Day04),
+	aoc::registerPuzzle<Day05>(year_2015, aoc::EDays::Day05),
+	aoc::registerPuzzle<Day06>(year_2015, aoc::EDays::Day06),
+	aoc::registerPuzzle<Day07>(year_2015, aoc::EDays::Day07),
+	aoc::registerPuzzle<Day08>(year_2015, aoc::EDays::Day08),
+	aoc::registerPuzzle<Day09>(year_2015, aoc::EDays::Day09),
+	aoc::registerPuzzle<Day10>(year_2015, aoc::EDays::Day10),
+	aoc::registerPuzzle<Day11>(year_2015, aoc::EDays::Day11),
+	aoc::registerPuzzle<Day12>(year_2015, aoc::EDays::Day12),
+	aoc::registerPuzzle<Day13>(year_2015, aoc::EDays::Day13),
+	aoc::registerPuzzle<Day14>(year_2015, aoc::EDays::Day14),
+	aoc::registerPuzzle<Day15>(year_2015, aoc::EDays::Day15),
+	aoc::registerPuzzle<Day16>(year_2015, aoc::EDays::Day16),
+	aoc::registerPuzzle<Day17>(year_2015, aoc::EDays::Day17),
+	aoc::registerPuzzle<Day18>(year_2015, aoc::EDays::Day18),
+	aoc::registerPuzzle<Day19>(year_2015, aoc::EDays::Day19),
+	aoc::registerPuzzle<Day20>(year_2015, aoc::EDays::Day20),
+	aoc::registerPuzzle<Day21>(year_2015, aoc::EDays::Day21),
+	aoc::registerPuzzle<Day23>(year_2015, aoc::EDays::Day23),
+};
+static_assert(aoc::isOrdered(puzzles_2015), "Puzzles must be ordered by day.");
 
 
 
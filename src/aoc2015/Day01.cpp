@@ -39,6 +39,7 @@ Your puzzle answer was 1797. */
 #include <algorithm>
 #include <limits>
 #include <string>
+#include <string_view>
 
 #include "../aoc/BasicDefinitions.h"
 #include "../aoc/BasicIO.h"
@@ -68,9 +69,9 @@ public:
 
 
 	// --- Elevator() ---
-	explicit Elevator(std::string input) : m_input {input}
+	explicit Elevator(std::string_view input) : m_input {input}
 	{
-		EXPECT(m_input.find_first_not_of("()") == std::string::npos, invalid_input_file_data);
+		EXPECT(m_input.find_first_not_of("()") == std::string_view::npos, invalid_input_file_data);
 	}
 
 
@@ -83,9 +84,9 @@ public:
 	// --- changeFloors() ---
 	void changeFloors()
 	{
-		const strSize_t loop_end {m_input.length()};
+		const strViewSize_t loop_end {m_input.length()};
 
-		for (strSize_t i {0}; i < loop_end; ++i) {
+		for (strViewSize_t i {0}; i < loop_end; ++i) {
 			changeFloorOnce(m_input[i]);
 
 			if ((m_atBasement == invalid_level) && (m_level == basement_level)) {
@@ -130,7 +131,7 @@ private:
 
 
 // Variables
-	const std::string m_input;					// Input data from file
+	const std::string_view m_input;				// Input data from file, owned by m_IO
 	int m_level {0};							// Current level of the elevator
 	strSize_t m_atBasement {invalid_level};		// First time the elevator stops at the basement
 };
@@ -146,7 +147,7 @@ private:
 void Day01::solve()
 {
 	try {
-		Elevator elevator {m_IO.getInputString()};
+		Elevator elevator {m_IO.getInputToken()};
 		m_IO.printFileValid();
 
 
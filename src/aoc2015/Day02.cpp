@@ -33,14 +33,14 @@ Your puzzle answer was 3812909. */
 #include "Day02.h"
 
 #include <algorithm>
-#include <fstream>
-#include <iostream>
 #include <iterator>
 #include <numeric>
+#include <string_view>
 #include <vector>
 
 #include "../aoc/BasicDefinitions.h"
 #include "../aoc/BasicIO.h"
+#include "../aoc/InputScanner.h"
 
 
 
@@ -73,18 +73,18 @@ using presentVector_t = std::vector<SPresent>;
 
 //=== Functions ==============================================================
 // --- readPresent() ---
-SPresent readPresent(std::ifstream& file)
+SPresent readPresent(std::string_view line)
 {
-	constexpr auto x_width {std::string_view("x").length()};
+	TokenScanner scanner {line};
 	SPresent result {};
 
-	file >> result.x;
-	file.ignore(x_width);
-	file >> result.y;
-	file.ignore(x_width);
-	file >> result.z;
+	result.x = scanner.nextInt<length_t>();
+	scanner.skip("x");
+	result.y = scanner.nextInt<length_t>();
+	scanner.skip("x");
+	result.z = scanner.nextInt<length_t>();
 
-	EXPECT(!file.fail(), invalid_input_file_data);
+	EXPECT(scanner.isEnd(), invalid_input_file_data);
 	EXPECT(std::min({result.x, result.y, result.z}) > invalid_length, invalid_input_file_data);
 
 	return result;
@@ -93,11 +93,13 @@ SPresent readPresent(std::ifstream& file)
 
 
 // --- readPresentVector() ---
-presentVector_t readPresentVector(std::ifstream file)
+presentVector_t readPresentVector(std::string_view input)
 {
 	presentVector_t result {};
-	while (!file.eof()) {
-		result.push_back(readPresent(file));
+	for (const auto line : Lines {input}) {
+		if (!line.empty()) {
+			result.push_back(readPresent(line));
+		}
 	}
 	return result;
 }
@@ -140,7 +142,7 @@ length_t getRibbonLength(const SPresent& present)
 void Day02::solve()
 {
 	try {
-		const presentVector_t presents {readPresentVector(m_IO.getInputFile())};
+		const presentVector_t presents {readPresentVector(m_IO.getInputData())};
 		m_IO.printFileValid();
 
 		const auto getSum = [&](const auto func) {
@@ -35,6 +35,7 @@
 #include <algorithm>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 
 #include "../aoc/BasicDefinitions.h"
 #include "../aoc/BasicIO.h"
@@ -93,9 +94,9 @@ public:
 
 
 	// --- PresentDelivery() ---
-	explicit PresentDelivery(std::string input) : m_input {input}
+	explicit PresentDelivery(std::string_view input) : m_input {input}
 	{
-		EXPECT(m_input.find_first_not_of("^>v<") == std::string::npos, invalid_input_file_data);
+		EXPECT(m_input.find_first_not_of("^>v<") == std::string_view::npos, invalid_input_file_data);
 	}
 
 
@@ -114,7 +115,7 @@ public:
 		std::fill(m_houses.begin(), m_houses.end(), 0);
 		m_houses[santa] = 1;
 
-		std::for_each(m_input.cbegin(), m_input.cend(), [&](const auto data) {
+		std::for_each(m_input.cbegin(), loop_end, [&](const auto data) {
 			santa.moveToNextHouse(data);
 			m_houses[santa] = 1;
 		});
@@ -134,7 +135,7 @@ public:
 		std::fill(m_houses.begin(), m_houses.end(), 0);
 		m_houses[santa] = 1;
 
-		std::for_each(m_input.cbegin(), m_input.cend(), [&](const auto data) {
+		std::for_each(m_input.cbegin(), loop_end, [&](const auto data) {
 			Distributor& distributor {santasTurn ? santa : robot};
 
 			distributor.moveToNextHouse(data);
@@ -149,7 +150,7 @@ public:
 
 private:
 // Variables
-	const std::string m_input;						// Input data from file
+	const std::string_view m_input;					// Input data from file, owned by m_IO
 	houses_t m_houses {grid_size, grid_size};		// Member variable to prevent multiple allocations
 };
 
@@ -164,7 +165,7 @@ private:
 void Day03::solve()
 {
 	try {
-		PresentDelivery delivery {m_IO.getInputString()};
+		PresentDelivery delivery {m_IO.getInputToken()};
 		m_IO.printFileValid();
 
 		m_IO.printSolution(delivery.calculateSantaDelivery(), EPart::Part1);
@@ -24,17 +24,142 @@ Your puzzle answer was 1038736. */
 //=== Include ================================================================
 #include "Day04.h"
 
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
 #include <limits>
 #include <string>
+#include <string_view>
 
 #include "../aoc/BasicDefinitions.h"
 #include "../aoc/BasicIO.h"
 #include "../aoc/md5.h"
+#include "../aoc/ThreadPool.h"
 
 
 
 namespace aoc2015 {
 using namespace aoc;
+namespace {
+
+
+
+//=== Types ==================================================================
+using nonce_t = unsigned int;
+
+
+
+//=== Constants ==============================================================
+constexpr nonce_t invalid_nonce {std::numeric_limits<nonce_t>::max()};
+constexpr nonce_t chunk_size {1 << 14};		// Numbers checked by a worker, before it looks for a new chunk
+constexpr unsigned int zeroes_part1 {5};
+constexpr unsigned int zeroes_part2 {6};
+
+
+
+//=== Functions ==============================================================
+// --- hasLeadingZeroes() ---
+// Checks the raw digest, so there is no need to convert it to a hex string. Each byte holds two hex digits.
+bool hasLeadingZeroes(const MD5::digest_type& digest, const unsigned int zeroes)
+{
+	const unsigned int full_bytes {zeroes / 2};
+
+	for (unsigned int i {0}; i < full_bytes; ++i) {
+		if (digest[i] != 0) {
+			return false;
+		}
+	}
+
+	return (zeroes % 2 == 0) || ((digest[full_bytes] & 0xF0) == 0);
+}
+
+
+
+//=== Class AdventCoinMiner ==================================================
+class AdventCoinMiner {
+public:
+// Constructors / destructor
+	AdventCoinMiner() = delete;
+	AdventCoinMiner(const AdventCoinMiner&) = delete;
+	AdventCoinMiner(AdventCoinMiner&&) = delete;
+	~AdventCoinMiner() = default;
+
+
+	// --- AdventCoinMiner() ---
+	explicit AdventCoinMiner(const std::string& secretKey)
+	{
+		EXPECT(!secretKey.empty(), invalid_input_file_data);
+		m_prefix.update(secretKey);
+	}
+
+
+// Operators
+	AdventCoinMiner& operator=(const AdventCoinMiner&) = delete;
+	AdventCoinMiner& operator=(AdventCoinMiner&&) = delete;
+
+
+// Functions
+	// --- findNonce() ---
+	// Returns the lowest number >= start, whose hash starts with the given number of zeroes.
+	// The numbers are checked in chunks by all workers, every chunk in front of the result is checked completely.
+	nonce_t findNonce(const unsigned int zeroes, const nonce_t start) const
+	{
+		const nonce_t result {ThreadPool::getShared().findLowest(start, invalid_nonce - 1, chunk_size, invalid_nonce,
+				[this, zeroes](const nonce_t first, const nonce_t last) { return searchRange(zeroes, first, last); })};
+
+		EXPECT(result != invalid_nonce, "Could not find a hash with enough leading zeroes.");
+		return result;
+	}
+
+
+private:
+// Functions
+	// --- searchRange() ---
+	// Returns the lowest number in [first, last], whose hash starts with the given number of zeroes.
+	// The numbers are hashed in batches using all SIMD lanes of the cpu.
+	nonce_t searchRange(const unsigned int zeroes, const nonce_t first, const nonce_t last) const
+	{
+		constexpr unsigned int max_batch {16};
+		constexpr std::size_t max_digits {std::numeric_limits<nonce_t>::digits10 + 1};
+		const unsigned int batch_size {std::min(md5_lanes(), max_batch)};
+
+		// Only the numbers are hashed, the state after the secret key is reused
+		char digits[max_batch][max_digits] {};
+		std::string_view suffixes[max_batch] {};
+		MD5::digest_type digests[max_batch] {};
+
+		for (nonce_t i {first}; i <= last; i += batch_size) {
+			const unsigned int used {static_cast<unsigned int>(std::min<nonce_t>(batch_size, last - i + 1))};
+
+			for (unsigned int j {0}; j < used; ++j) {
+				const char* const end {std::to_chars(digits[j], digits[j] + max_digits, i + j).ptr};
+				suffixes[j] = std::string_view(digits[j], static_cast<std::size_t>(end - digits[j]));
+			}
+
+			md5_multi(m_prefix, suffixes, digests, used);
+
+			for (unsigned int j {0}; j < used; ++j) {
+				if (hasLeadingZeroes(digests[j], zeroes)) {
+					return i + j;
+				}
+			}
+
+			if (last - i < batch_size) {	// prevents overflow of i
+				break;
+			}
+		}
+
+		return invalid_nonce;
+	}
+
+
+// Variables
+	MD5 m_prefix {};	// State after hashing the secret key (input data from file)
+};
+
+
+
+} /* anonymous namespace */
 
 
 
@@ -43,32 +168,15 @@ using namespace aoc;
 void Day04::solve()
 {
 	try {
-		constexpr auto max_loop {std::numeric_limits<unsigned int>::max()};
-		constexpr std::string_view zeroes_part1 {"00000"};
-		constexpr std::string_view zeroes_part2 {"000000"};
-		const std::string secretKey {m_IO.getInputString()};
+		AdventCoinMiner miner {m_IO.getInputString()};
 		m_IO.printFileValid();
 
 
-		unsigned int i {0};
-		std::string hash {};
-		// CHECK: if C++20 use starts_with() instead of compare() == 0
-		const auto calculateZeroes = [&](std::string_view zeroes){
-			for (; i < max_loop; ++i) {
-				hash = md5(secretKey + std::to_string(i));
-				if (hash.compare(0, zeroes.length(), zeroes) == 0) {
-					break;
-				}
-			}
-		};
-
-
-		calculateZeroes(zeroes_part1);
-		m_IO.printSolution(i, EPart::Part1);
+		const nonce_t nonce1 {miner.findNonce(zeroes_part1, 0)};
+		m_IO.printSolution(nonce1, EPart::Part1);
 
-		// Do not reset i, if there were not at least five zeroes, there were not six
-		calculateZeroes(zeroes_part2);
-		m_IO.printSolution(i, EPart::Part2);
+		// Start at the solution of part 1, if there were not at least five zeroes, there were not six
+		m_IO.printSolution(miner.findNonce(zeroes_part2, nonce1), EPart::Part2);
 
 
 	} catch (const std::exception& err) {
@@ -38,8 +38,9 @@ Your puzzle answer was 14110788. */
 #include "Day06.h"
 
 #include <algorithm>
-#include <fstream>
+#include <cstddef>
 #include <iostream>
+#include <iterator>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -47,6 +48,7 @@ Your puzzle answer was 14110788. */
 
 #include "../aoc/BasicDefinitions.h"
 #include "../aoc/BasicIO.h"
+#include "../aoc/InputScanner.h"
 #include "../aoc/TemplateContainer.h"
 
 
@@ -58,7 +60,8 @@ namespace {
 
 
 //=== Types ==================================================================
-using lightGrid_t = Grid<int>;
+using lightGrid_t = Grid<int>;		// Brightness of each light
+using switchGrid_t = Grid<bool>;	// Only on / off, needs 1/32 of the memory
 enum class ELightChange {invalid, on, off, toggle};
 
 
@@ -80,41 +83,41 @@ using instructionVector_t = std::vector<SInstruction>;
 
 //=== Functions ==============================================================
 // --- readInstruction() ---
-SInstruction readInstruction(std::ifstream& file) {
+SInstruction readInstruction(std::string_view line) {
+	TokenScanner scanner {line};
 	SInstruction result {};
-	std::string strBuffer;
 
 	// is toggle / turn on / turn off
-	file >> strBuffer;
-	if (strBuffer == "toggle") {
+	const auto command {scanner.nextToken()};
+	if (command == "toggle") {
 		result.turnLight = ELightChange::toggle;
-	} else if (strBuffer == "turn") {
-		file >> strBuffer;
-		if (strBuffer == "on") {
+	} else if (command == "turn") {
+		const auto state {scanner.nextToken()};
+		if (state == "on") {
 			result.turnLight = ELightChange::on;
-		} else if (strBuffer == "off") {
+		} else if (state == "off") {
 			result.turnLight = ELightChange::off;
 		}
 	}
 	EXPECT(result.turnLight != ELightChange::invalid, invalid_input_file_data);
 
-	constexpr auto separator_width {std::string_view(",").length()};
-	constexpr auto through_width {std::string_view("through ").length()};
+	using dimension_t = lightGrid_t::dimension_t;
 
 	// First point
-	file >> result.point1.x;
-	file.ignore(separator_width);
-	file >> result.point1.y;
-	file.ignore(through_width);
+	result.point1.x = scanner.nextInt<dimension_t>();
+	scanner.skip(",");
+	result.point1.y = scanner.nextInt<dimension_t>();
+	scanner.skip("through");
 
 	// Second point
-	file >> result.point2.x;
-	file.ignore(separator_width);
-	file >> result.point2.y;
+	result.point2.x = scanner.nextInt<dimension_t>();
+	scanner.skip(",");
+	result.point2.y = scanner.nextInt<dimension_t>();
 
 	// is data valid?
-	EXPECT(!file.fail(), invalid_input_file_data);
+	EXPECT(scanner.isEnd(), invalid_input_file_data);
 	EXPECT(std::max({result.point1.x, result.point1.y, result.point2.x, result.point2.y}) < grid_size, invalid_input_file_data);
+	EXPECT(result.point1.x <= result.point2.x && result.point1.y <= result.point2.y, invalid_input_file_data);
 
 	return result;
 }
@@ -122,24 +125,52 @@ SInstruction readInstruction(std::ifstream& file) {
 
 
 // --- readInstructionVector() ---
-instructionVector_t readInstructionVector(std::ifstream file)
+instructionVector_t readInstructionVector(std::string_view input)
 {
 	instructionVector_t result {};
-	while (!file.eof()) {
-		result.push_back(readInstruction(file));
+	for (const auto line : Lines {input}) {
+		if (!line.empty()) {
+			result.push_back(readInstruction(line));
+		}
 	}
 	return result;
 }
 
 
 
+// --- changeBrightness() ---
+// Changes the brightness of all lights in [first, last) (Part 2). Simple loops for each change, so they can be vectorized.
+template<typename iterator_t>
+void changeBrightness(const ELightChange change, const iterator_t first, const iterator_t last)
+{
+	switch (change) {
+	case ELightChange::on:
+		std::for_each(first, last, [](auto& light) { light += 1; });
+		break;
+
+	case ELightChange::off:
+		std::for_each(first, last, [](auto& light) { light = std::max(0, light - 1); });
+		break;
+
+	case ELightChange::toggle:
+		std::for_each(first, last, [](auto& light) { light += 2; });
+		break;
+
+	default:
+		THROW_ERROR(invalid_input_file_data); // Should already been handled at readInstruction(), but switch should have a default
+	};
+}
+
+
+
 //=== Class LightGrid ========================================================
-// Abstract grid of lights
-class LightGrid: public lightGrid_t {
+// Abstract grid of lights, each instruction is executed row by row
+template<typename grid_t>
+class LightGrid: public grid_t {
 public:
 // Constructors / destructor
 	// --- LightGrid() ---
-	LightGrid() : lightGrid_t(grid_size, grid_size)
+	LightGrid() : grid_t(grid_size, grid_size)
 	{
 		// Do nothing
 	}
@@ -159,46 +190,42 @@ public:
 	auto executeInstructions(const instructionVector_t& vec)
 	{
 		std::for_each(vec.cbegin(), vec.cend(), [&](const auto& data) {
-			changeLights(data);
+			for (auto y {data.point1.y}; y <= data.point2.y; ++y) {
+				changeRow(data.turnLight, y, data.point1.x, data.point2.x);
+			}
 		});
 
-		return accumulateData();
+		return this->accumulateData();
 	}
 
 
 protected:
 // Functions (depending on the part of the puzzle)
-	virtual void turnOn(const Position) = 0;
-	virtual void turnOff(const Position) = 0;
-	virtual void toggle(const Position) = 0;
-
+	// Changes all lights of row y from first to last (inclusive)
+	virtual void changeRow(const ELightChange change, const typename grid_t::dimension_t y,
+			const typename grid_t::dimension_t first, const typename grid_t::dimension_t last) = 0;
+};
 
-private:
-// Functions
-	// --- changeLights() ---
-	void changeLights(const SInstruction& input)
-	{
-		Position pos {};
-		const auto forAllLights = [&](const auto func){
-			for (pos.x = input.point1.x; pos.x <= input.point2.x; ++pos.x) {
-				for (pos.y = input.point1.y; pos.y <= input.point2.y; ++pos.y) {
-					func();
-				}
-			}
-		};
 
 
-		switch (input.turnLight) {
+// Implement methods specific to Part 1
+class LightGridPart1 final : public LightGrid<switchGrid_t> {
+protected:
+// Functions depending on the part of the puzzle
+	// --- changeRow() ---
+	void changeRow(const ELightChange change, const dimension_t y, const dimension_t first, const dimension_t last) override
+	{
+		switch (change) {
 		case ELightChange::on:
-			forAllLights([&](){turnOn(pos);});
+			setRow(y, first, last);
 			break;
 
 		case ELightChange::off:
-			forAllLights([&](){turnOff(pos);});
+			clearRow(y, first, last);
 			break;
 
 		case ELightChange::toggle:
-			forAllLights([&](){toggle(pos);});
+			flipRow(y, first, last);
 			break;
 
 		default:
@@ -209,58 +236,122 @@ private:
 
 
 
-// Implement methods specific to Part 1
-class LightGridPart1 final : public LightGrid {
+// Implement methods specific to Part 2
+class LightGridPart2 final : public LightGrid<lightGrid_t> {
 protected:
 // Functions depending on the part of the puzzle
-	// --- turnOn() ---
-	void turnOn(const Position pos) override
+	// --- changeRow() ---
+	void changeRow(const ELightChange change, const dimension_t y, const dimension_t first, const dimension_t last) override
 	{
-		operator [](pos) = 1;
+		const auto lights {row(y)};
+		changeBrightness(change, lights.begin() + first, lights.begin() + last + 1);
 	}
+};
+
+
+
+//=== Class CompressedLightGrid ==============================================
+/* Alternative to LightGridPart2: Only the coordinates, where a rectangle of an instruction starts or ends, are relevant.
+All lights between two of these boundaries always have the same brightness, so each cell of this grid represents a
+rectangle of lights. The costs depend on the number of instructions instead of the size of the grid. */
+class CompressedLightGrid {
+public:
+// Types
+	using dimension_t = lightGrid_t::dimension_t;
+	using boundaries_t = std::vector<dimension_t>;
+	using accumulate_t = lightGrid_t::accumulate_t;
+
+
+// Constructors / destructor
+	CompressedLightGrid() = delete;
+	CompressedLightGrid(const CompressedLightGrid&) = delete;
+	CompressedLightGrid(CompressedLightGrid&&) = delete;
+	~CompressedLightGrid() = default;
 
 
-	// --- turnOff() ---
-	void turnOff(const Position pos) override
+	// --- CompressedLightGrid() ---
+	// Only finds the boundaries, the cells are allocated by executeInstructions(), so getCellCount() can be checked first
+	explicit CompressedLightGrid(const instructionVector_t& vec) :
+			m_xBounds {getBoundaries(vec, &lightGrid_t::Position::x)},
+			m_yBounds {getBoundaries(vec, &lightGrid_t::Position::y)}
 	{
-		operator [](pos) = 0;
+		// Do nothing
 	}
 
 
-	// --- toggle() ---
-	void toggle(const Position pos) override
+// Operators
+	CompressedLightGrid& operator=(const CompressedLightGrid&) = delete;
+	CompressedLightGrid& operator=(CompressedLightGrid&&) = delete;
+
+
+// Getter
+	// --- getCellCount() ---
+	std::size_t getCellCount() const
 	{
-		data_t& light {operator [](pos)}; // just to make the next line easier to read
-		light = (light > 0) ? 0 : 1;
+		return (m_xBounds.size() - 1) * (m_yBounds.size() - 1);
 	}
-};
 
 
-
-// Implement methods specific to Part 2
-class LightGridPart2 final : public LightGrid {
-protected:
-// Functions depending on the part of the puzzle
-	// --- turnOn() ---
-	void turnOn(const Position pos) override
+// Functions
+	// --- executeInstructions() ---
+	accumulate_t executeInstructions(const instructionVector_t& vec)
 	{
-		operator [](pos) += 1;
+		const std::size_t width {m_xBounds.size() - 1};
+		m_cells.assign(getCellCount(), 0);
+
+		std::for_each(vec.cbegin(), vec.cend(), [&](const auto& data) {
+			const std::size_t x_first {findCell(m_xBounds, data.point1.x)};
+			const std::size_t x_end {findCell(m_xBounds, data.point2.x + 1)};
+			const std::size_t y_end {findCell(m_yBounds, data.point2.y + 1)};
+
+			for (std::size_t y {findCell(m_yBounds, data.point1.y)}; y < y_end; ++y) {
+				const auto row {std::next(m_cells.begin(), static_cast<std::ptrdiff_t>(y * width))};
+				changeBrightness(data.turnLight, std::next(row, static_cast<std::ptrdiff_t>(x_first)),
+						std::next(row, static_cast<std::ptrdiff_t>(x_end)));
+			}
+		});
+
+		// Each cell is weighted with the number of lights it represents
+		accumulate_t result {0};
+		for (std::size_t i {0}; i < m_cells.size(); ++i) {
+			const accumulate_t cell_width {m_xBounds[i % width + 1] - m_xBounds[i % width]};
+			const accumulate_t cell_height {m_yBounds[i / width + 1] - m_yBounds[i / width]};
+			result += m_cells[i] * cell_width * cell_height;
+		}
+		return result;
 	}
 
 
-	// --- turnOff() ---
-	void turnOff(const Position pos) override
+private:
+// Functions
+	// --- getBoundaries() ---
+	// All coordinates where a rectangle starts or ends (the coordinate after the last light of the rectangle)
+	static boundaries_t getBoundaries(const instructionVector_t& vec, dimension_t lightGrid_t::Position::* coordinate)
 	{
-		data_t& light {operator [](pos)}; // just to make the next line easier to read
-		light = std::max(0, light - 1);
+		boundaries_t result {0, grid_size};
+		for (const auto& data : vec) {
+			result.push_back(data.point1.*coordinate);
+			result.push_back(data.point2.*coordinate + 1);
+		}
+
+		std::sort(result.begin(), result.end());
+		result.erase(std::unique(result.begin(), result.end()), result.end());
+		return result;
 	}
 
 
-	// --- toggle() ---
-	void toggle(const Position pos) override
+	// --- findCell() ---
+	// Index of the cell starting at the boundary
+	static std::size_t findCell(const boundaries_t& bounds, const dimension_t boundary)
 	{
-		operator [](pos) += 2;
+		return static_cast<std::size_t>(std::distance(bounds.cbegin(), std::lower_bound(bounds.cbegin(), bounds.cend(), boundary)));
 	}
+
+
+// Variables
+	const boundaries_t m_xBounds;		// Sorted coordinates, where a column of cells starts
+	const boundaries_t m_yBounds;		// Sorted coordinates, where a row of cells starts
+	std::vector<int> m_cells {};		// Brightness of each cell
 };
 
 
@@ -274,14 +365,20 @@ protected:
 void Day06::solve()
 {
 	try {
-		const instructionVector_t input {readInstructionVector(m_IO.getInputFile())};
+		const instructionVector_t input {readInstructionVector(m_IO.getInputData())};
 		m_IO.printFileValid();
 
 		LightGridPart1 lights1 {};
 		m_IO.printSolution(lights1.executeInstructions(input), EPart::Part1);
 
-		LightGridPart2 lights2 {};
-		m_IO.printSolution(lights2.executeInstructions(input), EPart::Part2);
+		// Only use the compressed grid, if it has less cells than the grid of all lights
+		CompressedLightGrid compressedLights {input};
+		if (compressedLights.getCellCount() < static_cast<std::size_t>(grid_size) * grid_size) {
+			m_IO.printSolution(compressedLights.executeInstructions(input), EPart::Part2);
+		} else {
+			LightGridPart2 lights2 {};
+			m_IO.printSolution(lights2.executeInstructions(input), EPart::Part2);
+		}
 
 
 	} catch (const std::exception& err) {
@@ -50,11 +50,16 @@ Your puzzle answer was 14710. */
 #include "Day07.h"
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
-#include <fstream>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <queue>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <variant>
@@ -62,6 +67,7 @@ Your puzzle answer was 14710. */
 
 #include "../aoc/BasicDefinitions.h"
 #include "../aoc/BasicIO.h"
+#include "../aoc/InputScanner.h"
 
 
 
@@ -73,8 +79,7 @@ namespace {
 
 //=== Types ==================================================================
 using signal_t = uint16_t;
-using signalMap_t = std::unordered_map<std::string, signal_t>;
-using signalInput_t = std::variant<signal_t, std::string>;
+using signalInput_t = std::variant<signal_t, std::string_view>;	// views into the input data
 
 
 
@@ -84,7 +89,7 @@ struct SInstruction {
 	EGate gate {EGate::assign};
 	signalInput_t input1 {""};
 	signalInput_t input2 {""};
-	std::string output {""};
+	std::string_view output {""};
 };
 using instructionVector_t = std::vector<SInstruction>;
 
@@ -92,76 +97,45 @@ using instructionVector_t = std::vector<SInstruction>;
 
 //=== Functions ==============================================================
 // --- readInstruction() ---
-SInstruction readInstruction(const std::string& str)
+SInstruction readInstruction(std::string_view line)
 {
+	TokenScanner scanner {line};
 	SInstruction result {};
 
-	// Which gate is used
-	if (str.find(" AND ") != std::string::npos) {
-		result.gate = EGate::And;
-	} else if (str.find(" OR ") != std::string::npos) {
-		result.gate = EGate::Or;
-	} else if (str.find(" RSHIFT ") != std::string::npos) {
-		result.gate = EGate::rShift;
-	} else if (str.find(" LSHIFT ") != std::string::npos) {
-		result.gate = EGate::lShift;
-	} else if (str.find("NOT ") == 0) { // NOT can only be at the start of the string
-		result.gate = EGate::Not;
-	} else {
-		result.gate = EGate::assign;
-	}
-
-	// interpret input data
-	std::istringstream strStream {str};
-
 	// if possible get int data, else get the name of the wire
 	const auto readInput = [&]() {
+		const auto token {scanner.nextToken()};
 		signal_t intData {};
-		strStream >> intData;
-		if (!strStream.fail()) {
-			return signalInput_t {intData};
-		}
-
-		strStream.clear(std::ios_base::failbit & std::ios::badbit);
-		std::string strData {};
-		strStream >> strData;
-		return signalInput_t {strData};
+		return parseInt(token, intData) ? signalInput_t {intData} : signalInput_t {token};
 	};
 
-	constexpr auto space_width {std::string_view(" ").length()};
-	constexpr auto not_width {std::string_view("NOT ").length()};
-	constexpr auto operator_width {std::string_view("LSHIFT ").length()};	// Skip 'AND ', 'OR ', 'LSHIFT ' or 'RSHIFT '
-
-	switch (result.gate) {
-	// AND, OR, RSHIFT and LSHIFT have the same syntax
-	case EGate::And:
-	case EGate::Or:
-	case EGate::rShift:
-	case EGate::lShift:
+	// 'NOT x', 'x' or 'x AND y', 'x OR y', 'x LSHIFT y', 'x RSHIFT y'
+	if (scanner.skipIf("NOT ")) {
+		result.gate = EGate::Not;
 		result.input1 = readInput();
-		strStream.ignore(space_width);
-		strStream.ignore(operator_width, ' '); // Skip 'AND ', 'OR ', 'LSHIFT ' or 'RSHIFT '
-		result.input2 = readInput();
-		break;
-
-		// NOT and ASSIGN have similar syntax
-	case EGate::Not:
-		strStream.ignore(not_width);
-		[[fallthrough]];    // Only difference of NOT and ASSIGN syntax is the 'NOT' at the start
-	case EGate::assign:
+	} else {
 		result.input1 = readInput();
-		break;
-
-	default:
-		THROW_ERROR(invalid_input_file_data); // Should already been handled, but switch should have a default
+		if (!scanner.isNext("->")) {
+			const auto gate {scanner.nextToken()};
+			if (gate == "AND") {
+				result.gate = EGate::And;
+			} else if (gate == "OR") {
+				result.gate = EGate::Or;
+			} else if (gate == "LSHIFT") {
+				result.gate = EGate::lShift;
+			} else if (gate == "RSHIFT") {
+				result.gate = EGate::rShift;
+			} else {
+				THROW_ERROR(invalid_input_file_data);
+			}
+			result.input2 = readInput();
+		}
 	}
 
-
 	// same syntax for all gates
-	constexpr auto arrow_width {std::string_view("-> ").length()};
-	strStream.ignore(arrow_width);
-	strStream >> result.output;
-	EXPECT(!strStream.fail(), invalid_input_file_data);
+	scanner.skip("->");
+	result.output = scanner.nextToken();
+	EXPECT(scanner.isEnd(), invalid_input_file_data);
 
 	return result;
 }
@@ -169,132 +143,401 @@ SInstruction readInstruction(const std::string& str)
 
 
 // --- readInstructionVector() ---
-instructionVector_t readInstructionVector(std::ifstream file)
+instructionVector_t readInstructionVector(std::string_view input)
 {
 	instructionVector_t result {};
-
-	std::string buffer {};
-	while (!file.eof()) {
-		std::getline(file, buffer);
-		result.push_back(readInstruction(buffer));
+	for (const auto line : Lines {input}) {
+		if (!line.empty()) {
+			result.push_back(readInstruction(line));
+		}
 	}
-
 	return result;
 }
 
 
 
 //=== Class BobbysKit ========================================================
+/* The circuit is compiled once: each wire gets a dense id and the gates are sorted topologically, so every gate is
+executed after the gates providing its inputs. Then all signals are calculated by a single pass over the gates.
+After that, changing a signal only marks the gates using it as dirty. The next execution only calculates the dirty gates
+in topological order and marks the users of each changed output, so only the cone behind the changed wire is updated.
+executeBatch() calculates many variants of the input signals at once. */
 class BobbysKit {
 public:
+// Types
+	using wireId_t = std::size_t;
+
+	struct SBatchInput {
+		wireId_t wire {0};
+		std::vector<signal_t> signals {};	// one signal for each variant
+	};
+
+
+// Constructors / destructor
+	BobbysKit() = delete;
+	BobbysKit(const BobbysKit&) = delete;
+	BobbysKit(BobbysKit&&) = delete;
+	~BobbysKit() = default;
+
+
+	// --- BobbysKit() ---
+	explicit BobbysKit(const instructionVector_t& input)
+	{
+		m_gates.reserve(input.size());
+		std::for_each(input.cbegin(), input.cend(), [&](const auto& data) {
+			SGate gate {data.gate, readInput(data.input1), readInput(data.input2), getWireId(data.output)};
+			if (data.gate == EGate::assign || data.gate == EGate::Not) {
+				gate.input2 = SInput {};	// not used, so it should not be a dependency
+			}
+			m_gates.push_back(gate);
+		});
+
+		sortGates();
+		m_signals.assign(m_wireIds.size(), 0);
+		m_overridden.assign(m_wireIds.size(), false);
+		m_dirty.assign(m_gates.size(), false);
+	}
+
+
+// Operators
+	BobbysKit& operator=(const BobbysKit&) = delete;
+	BobbysKit& operator=(BobbysKit&&) = delete;
+
+
 // Functions
-	// --- clear() ---
-	void clear()
+	// --- getWire() ---
+	wireId_t getWire(std::string_view name) const
 	{
-		m_signals.clear();
+		const auto wire {m_wireIds.find(name)};
+		EXPECT(wire != m_wireIds.cend(), "Unknown wire: " + std::string {name});
+		return wire->second;
+	}
+
+
+	// --- getSignal() ---
+	signal_t getSignal(const wireId_t wire) const
+	{
+		return m_signals[wire];
 	}
 
 
 	// --- setSignal() ---
-	bool setSignal(const SInstruction& data)
+	// Overrides the signal of a wire, the gate providing the wire is ignored
+	void setSignal(const wireId_t wire, const signal_t signal)
 	{
-		if (m_signals.find(data.output) != m_signals.cend()) { // Do not override signals
-			return false;
+		m_overridden[wire] = true;
+		if (m_signals[wire] != signal) {
+			m_signals[wire] = signal;
+			markConsumers(wire);
 		}
+	}
 
 
-		// What is the first signal? If we do not know -> return
-		signal_t first_input {};
-		try {
-			first_input = std::get<signal_t>(data.input1);
-		} catch (const std::bad_variant_access&) {
-			const auto wire {std::get<std::string>(data.input1)};
-			if (m_signals.find(wire) != m_signals.cend()) {
-				first_input = m_signals.at(wire);
-			} else {
-				return false;
+	// --- executeSignals() ---
+	// The first call calculates all gates, later calls only the gates affected by changed signals
+	void executeSignals()
+	{
+		if (!m_executed) {
+			for (std::size_t i {0}; i < m_gates.size(); ++i) {
+				if (!m_overridden[m_gates[i].output]) {
+					m_signals[m_gates[i].output] = executeGate(m_gates[i]);
+				}
 			}
+
+			m_executed = true;
+			m_dirtyQueue = dirtyQueue_t {};
+			m_dirty.assign(m_gates.size(), false);
+			return;
 		}
 
+		// Gates are sorted topologically, so the lowest dirty gate does not depend on any other dirty gate
+		while (!m_dirtyQueue.empty()) {
+			const std::size_t i {m_dirtyQueue.top()};
+			m_dirtyQueue.pop();
+			m_dirty[i] = false;
 
-		// If the gate is not Assign or not: what is the second signal?
-		signal_t second_input {};
-		if (!(data.gate == EGate::assign || data.gate == EGate::Not)) {
-			try {
-				second_input = std::get<signal_t>(data.input2);
-			} catch (const std::bad_variant_access&) {
-				const auto wire {std::get<std::string>(data.input2)};
-				if (m_signals.find(wire) != m_signals.cend()) {
-					second_input = m_signals.at(wire);
-				} else {
-					return false;
-				}
+			const SGate& gate {m_gates[i]};
+			if (m_overridden[gate.output]) {
+				continue;
+			}
+
+			const signal_t signal {executeGate(gate)};
+			if (signal != m_signals[gate.output]) {
+				m_signals[gate.output] = signal;
+				markConsumers(gate.output);
 			}
 		}
+	}
+
 
+	// --- executeBatch() ---
+	// Overrides the wires of inputs for each variant and returns the signal of the wire result for each variant.
+	// Each wire holds the signals of all variants contiguously, so each gate is a simple loop over the variants, which
+	// can be vectorized. Wires overridden by setSignal() keep their signal in all variants.
+	std::vector<signal_t> executeBatch(const std::vector<SBatchInput>& inputs, const wireId_t result) const
+	{
+		constexpr std::size_t chunk_size {256};		// variants calculated at once, so all wires fit into the cache
+		const std::size_t wire_count {m_signals.size()};
+
+		EXPECT(!inputs.empty(), "No input for the batch.");
+		const std::size_t variants {inputs.front().signals.size()};
+		std::vector<bool> isInput(wire_count, false);
+		std::for_each(inputs.cbegin(), inputs.cend(), [&](const auto& input) {
+			EXPECT(input.signals.size() == variants, "Each input needs a signal for each variant.");
+			isInput[input.wire] = true;
+		});
+
+		std::vector<signal_t> batchResult(variants, 0);
+		std::vector<signal_t> lanes(wire_count * chunk_size, 0);
+		std::vector<signal_t> constants(2 * chunk_size, 0);		// constant inputs of the current gate
+
+		const auto getLanes = [&](const wireId_t wire) {
+			return &lanes[wire * chunk_size];
+		};
+
+		for (std::size_t first {0}; first < variants; first += chunk_size) {
+			const std::size_t count {std::min(chunk_size, variants - first)};
+			const auto first_signal {static_cast<std::ptrdiff_t>(first)};
+			const auto last_signal {static_cast<std::ptrdiff_t>(first + count)};
+
+			std::for_each(inputs.cbegin(), inputs.cend(), [&](const auto& input) {
+				std::copy(std::next(input.signals.cbegin(), first_signal), std::next(input.signals.cbegin(), last_signal),
+						getLanes(input.wire));
+			});
 
-		// Calculate output
-		signal_t outputSignal {0};
-		switch (data.gate) {
+			std::for_each(m_gates.cbegin(), m_gates.cend(), [&](const auto& gate) {
+				signal_t* const output {getLanes(gate.output)};
+				if (isInput[gate.output]) {
+					return;
+				}
+				if (m_overridden[gate.output]) {
+					std::fill_n(output, count, m_signals[gate.output]);
+					return;
+				}
+
+				const auto getInputLanes = [&](const SInput& input, signal_t* const constant) -> const signal_t* {
+					if (input.wire != no_wire) {
+						return getLanes(input.wire);
+					}
+					std::fill_n(constant, count, input.signal);
+					return constant;
+				};
+				executeGateLanes(gate.gate, getInputLanes(gate.input1, &constants[0]),
+						getInputLanes(gate.input2, &constants[chunk_size]), output, count);
+			});
+
+			std::copy_n(getLanes(result), count, std::next(batchResult.begin(), first_signal));
+		}
+
+		return batchResult;
+	}
+
+
+private:
+// Types
+	using dirtyQueue_t = std::priority_queue<std::size_t, std::vector<std::size_t>, std::greater<std::size_t> >;
+	static constexpr wireId_t no_wire {std::numeric_limits<wireId_t>::max()};
+
+	struct SInput {
+		wireId_t wire {no_wire};	// no_wire: the input is the constant signal
+		signal_t signal {0};
+	};
+
+	struct SGate {
+		EGate gate {EGate::assign};
+		SInput input1 {};
+		SInput input2 {};
+		wireId_t output {no_wire};
+	};
+
+
+// Functions
+	// --- getWireId() ---
+	wireId_t getWireId(std::string_view name)
+	{
+		return m_wireIds.try_emplace(name, m_wireIds.size()).first->second;
+	}
+
+
+	// --- readInput() ---
+	SInput readInput(const signalInput_t& input)
+	{
+		if (const auto signal {std::get_if<signal_t>(&input)}) {
+			return SInput {no_wire, *signal};
+		}
+		return SInput {getWireId(std::get<std::string_view>(input)), 0};
+	}
+
+
+	// --- markDirty() ---
+	void markDirty(const std::size_t gate)
+	{
+		if (!m_dirty[gate]) {
+			m_dirty[gate] = true;
+			m_dirtyQueue.push(gate);
+		}
+	}
+
+
+	// --- markConsumers() ---
+	// Marks all gates using the wire as input
+	void markConsumers(const wireId_t wire)
+	{
+		std::for_each(m_consumers[wire].cbegin(), m_consumers[wire].cend(), [&](const auto gate) { markDirty(gate); });
+	}
+
+
+	// --- getInput() ---
+	signal_t getInput(const SInput& input) const
+	{
+		return (input.wire == no_wire) ? input.signal : m_signals[input.wire];
+	}
+
+
+	// --- executeGate() ---
+	signal_t executeGate(const SGate& gate) const
+	{
+		const signal_t first_input {getInput(gate.input1)};
+		const signal_t second_input {getInput(gate.input2)};
+
+		switch (gate.gate) {
+		case EGate::assign:
+			return first_input;
+		case EGate::Not:
+			return static_cast<signal_t>(~first_input);
+
+		case EGate::And:
+			return first_input & second_input;
+		case EGate::Or:
+			return first_input | second_input;
+		case EGate::lShift:
+			return static_cast<signal_t>(first_input << second_input);
+		case EGate::rShift:
+			return static_cast<signal_t>(first_input >> second_input);
+
+		default:
+			THROW_ERROR(invalid_input_file_data); // Should already been handled, but switch should have a default
+		}
+	}
+
+
+	// --- executeGateLanes() ---
+	// Executes a gate for count variants, a separate loop for each gate, so each loop can be vectorized
+	static void executeGateLanes(const EGate gate, const signal_t* const first, const signal_t* const second,
+			signal_t* const output, const std::size_t count)
+	{
+		switch (gate) {
 		case EGate::assign:
-			outputSignal = first_input;
+			std::copy_n(first, count, output);
 			break;
 		case EGate::Not:
-			outputSignal = ~first_input;
+			for (std::size_t i {0}; i < count; ++i) {
+				output[i] = static_cast<signal_t>(~first[i]);
+			}
 			break;
 
 		case EGate::And:
-			outputSignal = first_input & second_input;
+			for (std::size_t i {0}; i < count; ++i) {
+				output[i] = first[i] & second[i];
+			}
 			break;
 		case EGate::Or:
-			outputSignal = first_input | second_input;
+			for (std::size_t i {0}; i < count; ++i) {
+				output[i] = first[i] | second[i];
+			}
 			break;
 		case EGate::lShift:
-			outputSignal = first_input << second_input;
+			for (std::size_t i {0}; i < count; ++i) {
+				output[i] = static_cast<signal_t>(first[i] << second[i]);
+			}
 			break;
 		case EGate::rShift:
-			outputSignal = first_input >> second_input;
+			for (std::size_t i {0}; i < count; ++i) {
+				output[i] = static_cast<signal_t>(first[i] >> second[i]);
+			}
 			break;
 
 		default:
 			THROW_ERROR(invalid_input_file_data); // Should already been handled, but switch should have a default
 		}
-
-		m_signals.insert({data.output, outputSignal});
-		return true;
 	}
 
 
-	// --- setSignal() ---
-	void setSignalB(signal_t input)
+	// --- sortGates() ---
+	// Kahn's algorithm: a gate is ready, if all gates providing its inputs are sorted
+	void sortGates()
 	{
-		m_signals.insert({"b", input});
-	}
+		const std::size_t wire_count {m_wireIds.size()};
+		std::vector<std::vector<std::size_t> > consumers(wire_count);	// gates using the wire as input
+		std::vector<unsigned int> missingInputs(m_gates.size(), 0);
+		std::vector<bool> isProvided(wire_count, false);
+
+		for (std::size_t i {0}; i < m_gates.size(); ++i) {
+			const SGate& gate {m_gates[i]};
+			EXPECT(!isProvided[gate.output], invalid_input_file_data);	// Each wire can only get a signal from one source
+			isProvided[gate.output] = true;
+
+			for (const SInput& input : {gate.input1, gate.input2}) {
+				if (input.wire != no_wire) {
+					consumers[input.wire].push_back(i);
+					++missingInputs[i];
+				}
+			}
+		}
 
+		// a wire without source would never get a signal
+		std::for_each(m_gates.cbegin(), m_gates.cend(), [&](const auto& gate) {
+			for (const SInput& input : {gate.input1, gate.input2}) {
+				EXPECT(input.wire == no_wire || isProvided[input.wire], invalid_input_file_data);
+			}
+		});
 
-	// --- executeSignals() ---
-	signal_t executeSignals(const instructionVector_t& input)
-	{
-		do {
-			int countSignalsChanged {0};
-			std::for_each(input.cbegin(), input.cend(), [&](const auto& data) {
-				if (setSignal(data)) {
-					++countSignalsChanged;
-				}
-			});
+		std::vector<std::size_t> order {};
+		order.reserve(m_gates.size());
+		for (std::size_t i {0}; i < m_gates.size(); ++i) {
+			if (missingInputs[i] == 0) {
+				order.push_back(i);
+			}
+		}
 
-			if (countSignalsChanged == 0) {
-				THROW_ERROR("Created infinite loop.");
+		// order grows while it is read
+		for (std::size_t next {0}; next < order.size(); ++next) {
+			for (const std::size_t consumer : consumers[m_gates[order[next]].output]) {
+				if (--missingInputs[consumer] == 0) {
+					order.push_back(consumer);
+				}
 			}
-		} while (m_signals.find("a") == m_signals.cend());
+		}
+
+		// all wires have a source, so the remaining gates are part of a loop
+		EXPECT(order.size() == m_gates.size(), "Created infinite loop.");
 
-		return m_signals["a"];
+		std::vector<SGate> sorted {};
+		sorted.reserve(m_gates.size());
+		std::for_each(order.cbegin(), order.cend(), [&](const auto i) { sorted.push_back(m_gates[i]); });
+		m_gates = std::move(sorted);
+
+		// dependency graph in sorted positions
+		m_consumers.assign(wire_count, {});
+		for (std::size_t i {0}; i < m_gates.size(); ++i) {
+			for (const SInput& input : {m_gates[i].input1, m_gates[i].input2}) {
+				if (input.wire != no_wire) {
+					m_consumers[input.wire].push_back(i);
+				}
+			}
+		}
 	}
 
 
-private:
 // Variables
-	signalMap_t m_signals {};
+	std::unordered_map<std::string_view, wireId_t> m_wireIds {};	// Only used to compile the circuit, views into the input data
+	std::vector<SGate> m_gates {};								// Sorted topologically
+	std::vector<signal_t> m_signals {};							// Signal of each wire
+	std::vector<bool> m_overridden {};							// Wires, whose signal is not provided by their gate
+	std::vector<std::vector<std::size_t> > m_consumers {};		// Gates using each wire as input
+	std::vector<bool> m_dirty {};								// Gates, which need to be calculated again
+	dirtyQueue_t m_dirtyQueue {};								// Dirty gates, lowest first
+	bool m_executed {false};									// All gates were calculated once
 };
 
 
@@ -308,16 +551,24 @@ private:
 void Day07::solve()
 {
 	try {
-		const instructionVector_t input {readInstructionVector(m_IO.getInputFile())};
+		const instructionVector_t input {readInstructionVector(m_IO.getInputData())};
 		m_IO.printFileValid();
 
-		BobbysKit kit {};
-		const signal_t signalA {kit.executeSignals(input)};
+		BobbysKit kit {input};
+		const auto wire_a {kit.getWire("a")};
+		const auto wire_b {kit.getWire("b")};
+		kit.executeSignals();
+		const signal_t signalA {kit.getSignal(wire_a)};
 		m_IO.printSolution(signalA, EPart::Part1);
 
-		kit.clear();
-		kit.setSignalB(signalA);
-		m_IO.printSolution(kit.executeSignals(input), EPart::Part2);
+		// both parts as variants of b in one batch, they have to match the full and the incremental execution
+		const std::vector<signal_t> batch {kit.executeBatch({{wire_b, {kit.getSignal(wire_b), signalA}}}, wire_a)};
+
+		kit.setSignal(wire_b, signalA);
+		kit.executeSignals();
+		const signal_t signalA2 {kit.getSignal(wire_a)};
+		EXPECT(batch == std::vector<signal_t>({signalA, signalA2}), "Batch does not match the incremental execution.");
+		m_IO.printSolution(signalA2, EPart::Part2);
 
 
 	} catch (const std::exception& err) {
@@ -44,16 +44,15 @@ Your puzzle answer was 2046. */
 #include "Day08.h"
 
 #include <algorithm>
-#include <fstream>
 #include <iostream>
 #include <iterator>
 #include <numeric>
-#include <string>
 #include <string_view>
 #include <vector>
 
 #include "../aoc/BasicDefinitions.h"
 #include "../aoc/BasicIO.h"
+#include "../aoc/InputScanner.h"
 
 
 
@@ -64,7 +63,7 @@ namespace {
 
 
 //=== Types ==================================================================
-using strVector_t = std::vector<std::string>;
+using strVector_t = std::vector<std::string_view>;	// views into the input data
 
 
 
@@ -139,16 +138,16 @@ auto sizeDifferencePart2(std::string_view input)
 
 
 // --- readStrVector() ---
-strVector_t readStrVector(std::ifstream file)
+strVector_t readStrVector(std::string_view input)
 {
 	strVector_t result {};
-	std::string buffer {};
-
-	while (!file.eof()) {
-		std::getline(file, buffer);
-		result.push_back(buffer);
+	for (const auto line : Lines {input}) {
+		if (!line.empty()) {
+			result.push_back(line);
+		}
 	}
 
+	EXPECT(!result.empty(), invalid_input_file_data);
 	return result;
 }
 
@@ -163,7 +162,7 @@ strVector_t readStrVector(std::ifstream file)
 void Day08::solve()
 {
 	try {
-		const strVector_t input {readStrVector(m_IO.getInputFile())};
+		const strVector_t input {readStrVector(m_IO.getInputData())};
 		m_IO.printFileValid();
 
 		const auto getSum = [&](const auto func) {
@@ -35,16 +35,15 @@ Your puzzle answer was 909. */
 #include "Day09.h"
 
 #include <algorithm>
-#include <fstream>
-#include <iostream>
-#include <iterator>
+#include <cstddef>
 #include <limits>
-#include <list>
-#include <string>
-#include <utility>
+#include <string_view>
+#include <vector>
 
 #include "../aoc/BasicDefinitions.h"
 #include "../aoc/BasicIO.h"
+#include "../aoc/InputScanner.h"
+#include "../aoc/PermutationSearch.h"
 #include "../aoc/TemplateContainer.h"
 
 
@@ -57,77 +56,210 @@ namespace {
 
 //=== Types ==================================================================
 using distance_t = unsigned int;
-using locationPair_t = std::pair<std::string, std::string>;
-using locationListData_t = std::list<std::string>;
-
-using distanceMap_t = DoubleKeyMap<std::string, distance_t>;
-using locationList_t = UniqueList<std::string>;
+using locationId_t = WeightMatrix<distance_t>::id_t;
+
+
+
+//=== Constants ==============================================================
+constexpr distance_t no_route {std::numeric_limits<distance_t>::max()};
+constexpr locationId_t max_table_locations {20};	// the table needs 2^n * n routes, see RouteSolver::max_table_bytes
+constexpr locationId_t max_locations {64};			// more than max_table_locations are searched without table
+
+
+
+//=== Class RouteSolver ======================================================
+/* Held-Karp: the shortest / longest route through a set of locations, which ends at a location, only depends on the set
+and the end, not on the order of the other locations. So each (set, end) is calculated once from the smaller sets,
+which is O(n^2 * 2^n) instead of O(n!) for trying all permutations. If the table does not fit into memory, the routes
+are searched by branch-and-bound instead. */
+class RouteSolver {
+public:
+// Constructors / destructor
+	RouteSolver() = delete;
+	RouteSolver(const RouteSolver&) = delete;
+	RouteSolver(RouteSolver&&) = delete;
+	~RouteSolver() = default;
+
+
+	// --- RouteSolver() ---
+	// Reads lines like "London to Dublin = 464"
+	explicit RouteSolver(std::string_view input)
+	{
+		for (const auto line : Lines {input}) {
+			if (line.empty()) {
+				continue;
+			}
+
+			TokenScanner scanner {line};
+			const auto from {scanner.nextToken()};
+			scanner.skip("to");
+			const auto to {scanner.nextToken()};
+			scanner.skip("=");
+			const auto distance {scanner.nextInt<distance_t>()};
+			EXPECT(scanner.isEnd() && from != to && distance != no_route, invalid_input_file_data);
+
+			m_distances.setWeight(from, to, distance);
+		}
+
+		const auto size {getSize()};
+		EXPECT(size > 0, invalid_input_file_data);
+		EXPECT(size <= max_locations, "Too many locations.");
+	}
 
 
+// Operators
+	RouteSolver& operator=(const RouteSolver&) = delete;
+	RouteSolver& operator=(RouteSolver&&) = delete;
 
-struct SInputData {
-	locationPair_t locationPair {std::make_pair("", "")};
-	distance_t distance {0};
-};
 
+// Functions
+	// --- solve() ---
+	// Uses the table, if it fits into memory, and the search otherwise
+	void solve()
+	{
+		if (getSize() <= max_table_locations) {
+			solveTable();
+		} else {
+			solveSearch();
+		}
+	}
 
 
-struct SMapAndList {// distanceMap and locationList are created together
-	distanceMap_t map {};
-	locationList_t list {};
-};
+// Getter
+	// --- getShortest() ---
+	distance_t getShortest() const
+	{
+		return m_shortest;
+	}
 
 
+	// --- getLongest() ---
+	distance_t getLongest() const
+	{
+		return m_longest;
+	}
 
-//=== Functions ==============================================================
-// --- readInputData() ---
-SInputData readInputData(std::ifstream& file)
-{
-	SInputData result {};
-
-	file >> result.locationPair.first;
-	constexpr auto to_width {std::string_view("to ").length()};
-	file.ignore(to_width);
-	file >> result.locationPair.second;
-	constexpr auto equals_width {std::string_view("= ").length()};
-	file.ignore(equals_width);
-	file >> result.distance;
-
-	EXPECT(!file.fail(), invalid_input_file_data);
-	return result;
-}
 
+private:
+// Types
+	struct SRoute {
+		distance_t shortest {no_route};		// no_route, if the route does not exist
+		distance_t longest {0};
+	};
 
+	// 2^20 * 20 routes of 8 bytes are about 168 MB, one more location would double it
+	static constexpr std::size_t max_table_bytes {std::size_t {1} << 28};
+	static_assert((std::size_t {1} << max_table_locations) * max_table_locations * sizeof(SRoute) <= max_table_bytes,
+			"The table of routes is too large.");
+
+	using search_t = PermutationSearch<long long>;
+
+
+// Functions
+	// --- solveTable() ---
+	// Calculates the shortest and the longest route at once
+	void solveTable()
+	{
+		const auto size {getSize()};
+		const std::size_t sets {std::size_t {1} << size};
+
+		// routes[set * size + end]: route through all locations of set, which ends at end
+		std::vector<SRoute> routes(sets * size);
+		for (locationId_t start {0}; start < size; ++start) {
+			routes[(std::size_t {1} << start) * size + start] = SRoute {0, 0};
+		}
+
+		for (std::size_t set {1}; set < sets; ++set) {
+			for (locationId_t end {0}; end < size; ++end) {
+				const auto& route {routes[set * size + end]};
+				if (route.shortest == no_route) {    // end is not in set or there is no route
+					continue;
+				}
+
+				for (locationId_t next {0}; next < size; ++next) {
+					const auto distance {getDistance(end, next)};
+					if ((set & (std::size_t {1} << next)) != 0 || distance == no_route) {
+						continue;
+					}
+
+					distance_t shortest {};
+					distance_t longest {};
+					// no_route is reserved, so a shortest route of this length is too long as well
+					EXPECT(!__builtin_add_overflow(route.shortest, distance, &shortest) && shortest != no_route
+							&& !__builtin_add_overflow(route.longest, distance, &longest), "Route is too long.");
+
+					auto& nextRoute {routes[(set | (std::size_t {1} << next)) * size + next]};
+					nextRoute.shortest = std::min(nextRoute.shortest, shortest);
+					nextRoute.longest = std::max(nextRoute.longest, longest);
+				}
+			}
+		}
+
+		for (locationId_t end {0}; end < size; ++end) {
+			const auto& route {routes[(sets - 1) * size + end]};
+			if (route.shortest != no_route) {
+				m_shortest = std::min(m_shortest, route.shortest);
+				m_longest = std::max(m_longest, route.longest);
+			}
+		}
+		EXPECT(m_shortest != no_route, "There is no route through all locations.");
+	}
 
-// --- readMapAndList() ---
-SMapAndList readMapAndList(std::ifstream file)
-{
-	SMapAndList result {};
 
-	while (!file.eof()) {
-		SInputData buffer {readInputData(file)};
-		result.map.insert(buffer.locationPair, buffer.distance);
-		result.list.addData(buffer.locationPair.first);
-		result.list.addData(buffer.locationPair.second);
+	// --- solveSearch() ---
+	// Branch-and-bound without a table. A missing route is an edge worse than all routes together, so an order using it
+	// only wins, if there is no route through all locations.
+	void solveSearch()
+	{
+		const auto size {getSize()};
+
+		search_t::cost_t penalty {1};
+		for (locationId_t from {0}; from < size; ++from) {
+			for (locationId_t to {from + 1}; to < size; ++to) {
+				if (getDistance(from, to) != no_route) {
+					penalty += static_cast<search_t::cost_t>(getDistance(from, to));
+				}
+			}
+		}
+
+		const auto getEdge = [this](const search_t::id_t from, const search_t::id_t to, const search_t::cost_t missing) {
+			const auto distance {getDistance(static_cast<locationId_t>(from), static_cast<locationId_t>(to))};
+			return (distance == no_route) ? missing : static_cast<search_t::cost_t>(distance);
+		};
+
+		search_t shortest {size, [&getEdge, penalty](const auto from, const auto to) { return getEdge(from, to, penalty); }};
+		const search_t::cost_t shortestLength {shortest.find(search_t::EGoal::minimum)};
+		EXPECT(shortestLength < penalty, "There is no route through all locations.");
+		EXPECT(shortestLength < static_cast<search_t::cost_t>(no_route), "Route is too long.");
+
+		search_t longest {size, [&getEdge, penalty](const auto from, const auto to) { return getEdge(from, to, -penalty); }};
+		const search_t::cost_t longestLength {longest.find(search_t::EGoal::maximum)};
+		EXPECT(longestLength <= static_cast<search_t::cost_t>(std::numeric_limits<distance_t>::max()), "Route is too long.");
+
+		m_shortest = static_cast<distance_t>(shortestLength);
+		m_longest = static_cast<distance_t>(longestLength);
 	}
 
-	return result;
-}
 
+	// --- getSize() ---
+	std::size_t getSize() const
+	{
+		return m_distances.size();
+	}
 
 
-// --- getTravelDistance() ---
-auto getTravelDistance(const SMapAndList& data)
-{
-	const auto loop_end {data.list.cend()};
-	distance_t result {0};
+	// --- getDistance() ---
+	distance_t getDistance(const locationId_t from, const locationId_t to) const
+	{
+		return m_distances(from, to);
+	}
 
-	for (auto i {data.list.cbegin()}, j {std::next(i)}; j != loop_end; std::advance(i, 1), std::advance(j, 1)) {
-		result += data.map.find(std::make_pair(*i, *j));
-	};
 
-	return result;
-}
+// Variables
+	WeightMatrix<distance_t> m_distances {true, no_route};	// no_route, if not connected
+	distance_t m_shortest {no_route};
+	distance_t m_longest {0};
+};
 
 
 
@@ -140,19 +272,12 @@ auto getTravelDistance(const SMapAndList& data)
 void Day09::solve()
 {
 	try {
-		SMapAndList input {readMapAndList(m_IO.getInputFile())};
+		RouteSolver routes {m_IO.getInputData()};
 		m_IO.printFileValid();
 
-		distance_t minDistance {std::numeric_limits<distance_t>::max()};
-		distance_t maxDistance {std::numeric_limits<distance_t>::min()};
-		do {
-			const auto travelDistance {getTravelDistance(input)};
-			minDistance = std::min(minDistance, travelDistance);
-			maxDistance = std::max(maxDistance, travelDistance);
-		} while (input.list.nextPermutation());
-
-		m_IO.printSolution(minDistance, EPart::Part1);
-		m_IO.printSolution(maxDistance, EPart::Part2);
+		routes.solve();
+		m_IO.printSolution(routes.getShortest(), EPart::Part1);
+		m_IO.printSolution(routes.getLongest(), EPart::Part2);
 
 
 	} catch (const std::exception& err) {
@@ -25,12 +25,20 @@ Your puzzle answer was 3579328. */
 //=== Include ================================================================
 #include "Day10.h"
 
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <iterator>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "../aoc/BasicDefinitions.h"
 #include "../aoc/BasicIO.h"
+#include "../aoc/ThreadPool.h"
 
 
 
@@ -40,37 +48,522 @@ namespace {
 
 
 
+//=== Types ==================================================================
+using length_t = unsigned long long;
+using elementId_t = std::uint8_t;
+
+constexpr std::size_t element_count {92};
+constexpr std::size_t max_decay_products {6};
+using counts_t = std::array<length_t, element_count>;
+
+struct SElement {
+	std::string_view sequence;										// digits of the element
+	std::size_t decayCount;											// number of used entries in decay
+	std::array<elementId_t, max_decay_products> decay;				// elements the sequence splits into after one step
+};
+
+
+
+//=== Constants ==============================================================
+/* Conway's cosmological decomposition: every sequence of the digits 1 to 3 (except "22") decays after a few steps into
+a compound of these 92 common elements, which never interact with their neighbours again. So the decay of each element is
+one row of a (sparse) transition matrix and only the count of each element is needed to get the length of the sequence.
+Elements are sorted by length, the table has been generated by evolving the sequences and splitting them where
+both sides stay independent. */
+constexpr std::array<SElement, element_count> elements {{
+	{"3",                                          1, { 2}},                      //  0
+	{"12",                                         1, { 6}},                      //  1
+	{"13",                                         1, { 7}},                      //  2
+	{"22",                                         1, { 3}},                      //  3
+	{"132",                                        1, {15}},                      //  4
+	{"312",                                        1, {16}},                      //  5
+	{"1112",                                       1, { 8}},                      //  6
+	{"1113",                                       1, { 9}},                      //  7
+	{"3112",                                       1, {17}},                      //  8
+	{"3113",                                       1, {18}},                      //  9
+	{"11131",                                      1, {19}},                      // 10
+	{"11132",                                      1, {20}},                      // 11
+	{"13211",                                      1, {29}},                      // 12
+	{"31132",                                      1, {32}},                      // 13
+	{"32112",                                      1, {31}},                      // 14
+	{"111312",                                     1, {34}},                      // 15
+	{"131112",                                     1, {30}},                      // 16
+	{"132112",                                     1, {38}},                      // 17
+	{"132113",                                     1, {39}},                      // 18
+	{"311311",                                     1, {33}},                      // 19
+	{"311312",                                     1, {43}},                      // 20
+	{"311332",                                     3, { 4,  1,  5}},              // 21
+	{"1112133",                                    2, {27,  0}},                  // 22
+	{"1113222",                                    1, {21}},                      // 23
+	{"1321132",                                    1, {52}},                      // 24
+	{"1322112",                                    1, {40}},                      // 25
+	{"1322113",                                    1, {41}},                      // 26
+	{"3112112",                                    1, {42}},                      // 27
+	{"3112221",                                    2, { 4, 12}},                  // 28
+	{"11131221",                                   1, {45}},                      // 29
+	{"11133112",                                   2, { 5, 14}},                  // 30
+	{"13122112",                                   1, {51}},                      // 31
+	{"13211312",                                   1, {57}},                      // 32
+	{"13211321",                                   1, {58}},                      // 33
+	{"31131112",                                   1, {44}},                      // 34
+	{"123222112",                                  1, {49}},                      // 35
+	{"123222113",                                  1, {50}},                      // 36
+	{"311311222",                                  2, {24,  4}},                  // 37
+	{"1113122112",                                 1, {54}},                      // 38
+	{"1113122113",                                 1, {55}},                      // 39
+	{"1113222112",                                 1, {46}},                      // 40
+	{"1113222113",                                 1, {47}},                      // 41
+	{"1321122112",                                 1, {60}},                      // 42
+	{"1321131112",                                 1, {59}},                      // 43
+	{"1321133112",                                 4, {10,  3,  1, 14}},          // 44
+	{"3113112211",                                 1, {53}},                      // 45
+	{"3113322112",                                 2, { 4, 35}},                  // 46
+	{"3113322113",                                 2, { 4, 36}},                  // 47
+	{"13221133112",                                3, {23,  1, 14}},              // 48
+	{"111213322112",                               1, {61}},                      // 49
+	{"111213322113",                               1, {62}},                      // 50
+	{"111311222112",                               2, {13, 25}},                  // 51
+	{"111312211312",                               1, {65}},                      // 52
+	{"132113212221",                               1, {68}},                      // 53
+	{"311311222112",                               2, {24, 25}},                  // 54
+	{"311311222113",                               2, {24, 26}},                  // 55
+	{"1322113312211",                              3, {23,  1, 28}},              // 56
+	{"11131221131112",                             1, {66}},                      // 57
+	{"11131221131211",                             1, {71}},                      // 58
+	{"11131221133112",                             3, {37,  1, 14}},              // 59
+	{"11131221222112",                             1, {64}},                      // 60
+	{"31121123222112",                             1, {69}},                      // 61
+	{"31121123222113",                             1, {70}},                      // 62
+	{"311322113212221",                            1, {73}},                      // 63
+	{"3113112211322112",                           1, {72}},                      // 64
+	{"3113112221131112",                           2, {24, 48}},                  // 65
+	{"3113112221133112",                           5, {24,  2,  3,  1, 14}},      // 66
+	{"13221133122211332",                          6, {23,  1,  9,  3,  1,  5}},  // 67
+	{"111312211312113211",                         1, {79}},                      // 68
+	{"132112211213322112",                         1, {77}},                      // 69
+	{"132112211213322113",                         1, {78}},                      // 70
+	{"311311222113111221",                         2, {24, 56}},                  // 71
+	{"13211321222113222112",                       1, {80}},                      // 72
+	{"13211322211312113211",                       1, {83}},                      // 73
+	{"132211331222113112211",                      3, {23,  1, 63}},              // 74
+	{"12322211331222113112211",                    4, {22,  3,  1, 63}},          // 75
+	{"31131122211311122113222",                    2, {24, 67}},                  // 76
+	{"111312212221121123222112",                   1, {84}},                      // 77
+	{"111312212221121123222113",                   1, {85}},                      // 78
+	{"311311222113111221131221",                   2, {24, 74}},                  // 79
+	{"11131221131211322113322112",                 2, {76, 35}},                  // 80
+	{"312211322212221121123222112",                1, {86}},                      // 81
+	{"312211322212221121123222113",                1, {87}},                      // 82
+	{"1113122113322113111221131221",               2, {37, 75}},                  // 83
+	{"3113112211322112211213322112",               1, {88}},                      // 84
+	{"3113112211322112211213322113",               1, {89}},                      // 85
+	{"13112221133211322112211213322112",           5, {11,  2,  3,  1, 81}},      // 86
+	{"13112221133211322112211213322113",           5, {11,  2,  3,  1, 82}},      // 87
+	{"1321132122211322212221121123222112",         1, {90}},                      // 88
+	{"1321132122211322212221121123222113",         1, {91}},                      // 89
+	{"111312211312113221133211322112211213322112", 3, {76,  1, 81}},              // 90
+	{"111312211312113221133211322112211213322113", 3, {76,  1, 82}},              // 91
+}};
+
+constexpr int decompose_limit {24};		// all sequences have decayed into elements after 24 steps, but digits > 3 (e.g.
+										// after a run of four equal digits) are transuranic elements, which are not in the table
+constexpr int verify_steps {12};		// steps the decomposition is checked against the generated sequence
+
+
+
 //=== Functions ==============================================================
-// --- lookAndTell() ------------------
-std::string lookAndTell(std::string_view input)
+// --- writeRuns() ------------------
+// Writes the look-and-say of input to output, which needs space for 2 * input.length() bytes. Returns the new end of output.
+char* writeRuns(std::string_view input, char* output)
 {
+	constexpr std::size_t max_single_digit {9};
 	const auto loop_end {input.cend()};
-	const auto input_length {input.length()};
-	std::string result {};
-	result.reserve(input_length * 2);
 
-	int count {1};
-	char buffer {input[0]};
+	for (auto i {input.cbegin()}; i != loop_end;) {
+		const char digit {*i};
+		const auto runBegin {i};
+		while (i != loop_end && *i == digit) {
+			std::advance(i, 1);
+		}
 
-	for (auto i {std::next(input.cbegin())}; i != loop_end; std::advance(i, 1)) {
-		if (*i == buffer) {
-			++count;
+		const auto count {static_cast<std::size_t>(std::distance(runBegin, i))};
+		if (count <= max_single_digit) {    // longer runs are only possible in the starting sequence
+			*output++ = static_cast<char>('0' + count);
 		} else {
-			result.append(std::to_string(count));
-			result.push_back(buffer);
+			output = std::to_chars(output, output + count, count).ptr;
+		}
+		*output++ = digit;
+	}
+
+	return output;
+}
+
+
+
+// --- countRuns() ------------------
+// Length of the look-and-say of input
+std::size_t countRuns(std::string_view input)
+{
+	constexpr std::size_t max_single_digit {9};
+	const auto loop_end {input.cend()};
+	std::size_t result {0};
+
+	for (auto i {input.cbegin()}; i != loop_end;) {
+		const char digit {*i};
+		const auto runBegin {i};
+		while (i != loop_end && *i == digit) {
+			std::advance(i, 1);
+		}
+
+		auto count {static_cast<std::size_t>(std::distance(runBegin, i))};
+		for (; count > max_single_digit; count /= 10) {
+			++result;
+		}
+		result += 2;
+	}
+
+	return result;
+}
+
+
+
+// --- nextRunBoundary() ------------------
+// First position >= pos, where a new run starts (or sequence.length())
+strViewSize_t nextRunBoundary(std::string_view sequence, strViewSize_t pos)
+{
+	while (pos > 0 && pos < sequence.length() && sequence[pos] == sequence[pos - 1]) {
+		++pos;
+	}
+	return pos;
+}
+
+
+
+//=== Class LookAndSay =======================================================
+class LookAndSay final {
+public:
+// Constructors / destructor
+	LookAndSay() = delete;
+	LookAndSay(const LookAndSay&) = delete;
+	LookAndSay(LookAndSay&&) = delete;
+	~LookAndSay() = default;
+
+	LookAndSay(std::string_view sequence, int expectedSteps, bool isParallel = false);
+
+
+// Operators
+	LookAndSay& operator=(const LookAndSay&) = delete;
+	LookAndSay& operator=(LookAndSay&&) = delete;
+
+
+// Getter
+	std::string_view getSequence() const;
+	std::size_t getLength() const;
+
+
+// Functions
+	void step();		// uses the shared thread pool for long sequences, if isParallel
+
+
+private:
+// Functions
+	void stepSequential();
+	void stepParallel();
+	void reserveNext(std::size_t size);
+
+
+// Constants
+	static constexpr double growth_factor {1.3035772690342963};	// Conway's constant
+	static constexpr std::size_t block_size {1 << 16};			// input bytes between capacity checks / per parallel task
+
+
+// Variables
+	std::array<std::string, 2> m_buffers {};	// ping-pong buffers, only the first m_length bytes of the current one are valid
+	std::size_t m_current {0};					// index of the buffer holding the sequence
+	std::size_t m_length {0};					// length of the sequence
+	bool m_isParallel {false};					// false: always sequential
+};
+
+
+
+// --- LookAndSay::LookAndSay() ---
+// The buffers are sized for expectedSteps, they only grow, if the sequence grows faster
+LookAndSay::LookAndSay(std::string_view sequence, const int expectedSteps, const bool isParallel)
+	: m_length {sequence.length()}, m_isParallel {isParallel}
+{
+	EXPECT(!sequence.empty(), "Sequence must not be empty.");
+
+	constexpr double margin {1.25};    // the growth is larger for the first steps
+	const auto expectedLength {static_cast<double>(m_length) * std::pow(growth_factor, expectedSteps) * margin};
+	const auto capacity {std::max(static_cast<std::size_t>(expectedLength), 2 * m_length)};
+
+	for (auto& buffer : m_buffers) {
+		buffer.resize(capacity);
+	}
+	sequence.copy(m_buffers[m_current].data(), m_length);
+}
+
+
+
+// --- LookAndSay::getSequence() ---
+std::string_view LookAndSay::getSequence() const
+{
+	return std::string_view {m_buffers[m_current].data(), m_length};
+}
+
+
+
+// --- LookAndSay::getLength() ---
+std::size_t LookAndSay::getLength() const
+{
+	return m_length;
+}
+
+
+
+// --- LookAndSay::step() ---
+void LookAndSay::step()
+{
+	// short sequences do not need the pool, so it is only created for long ones
+	if (m_isParallel && m_length > 2 * block_size && ThreadPool::getShared().getSize() > 1) {
+		stepParallel();
+	} else {
+		stepSequential();
+	}
+	m_current ^= 1;
+}
+
+
+
+// --- LookAndSay::stepSequential() ---
+void LookAndSay::stepSequential()
+{
+	const auto input {getSequence()};
+	std::size_t length {0};
+
+	for (strViewSize_t first {0}; first < input.length();) {
+		const auto last {nextRunBoundary(input, std::min(first + block_size, input.length()))};
+		reserveNext(length + 2 * (last - first));
+
+		char* const output {m_buffers[m_current ^ 1].data()};
+		length = static_cast<std::size_t>(writeRuns(input.substr(first, last - first), output + length) - output);
+		first = last;
+	}
+
+	m_length = length;
+}
+
+
+
+// --- LookAndSay::stepParallel() ---
+// Splits the sequence at run boundaries, counts the output of each chunk, and writes all chunks at their final offsets
+void LookAndSay::stepParallel()
+{
+	const auto input {getSequence()};
+	ThreadPool& pool {ThreadPool::getShared()};
+	const auto chunkCount {std::min(pool.getSize() * 4, input.length() / block_size)};
+
+	std::vector<strViewSize_t> bounds {0};
+	for (std::size_t i {1}; i < chunkCount; ++i) {
+		bounds.push_back(nextRunBoundary(input, std::max(bounds.back(), input.length() * i / chunkCount)));
+	}
+	bounds.push_back(input.length());
+
+	auto forEachChunk = [&pool, &bounds](const auto& func) {
+		pool.forEach(bounds.size() - 1, func);
+	};
+
+	std::vector<std::size_t> offsets(bounds.size(), 0);
+	forEachChunk([&input, &bounds, &offsets](const std::size_t i) {
+		offsets[i + 1] = countRuns(input.substr(bounds[i], bounds[i + 1] - bounds[i]));
+	});
+	for (std::size_t i {1}; i < offsets.size(); ++i) {
+		offsets[i] += offsets[i - 1];
+	}
+
+	reserveNext(offsets.back());
+	char* const output {m_buffers[m_current ^ 1].data()};
+	forEachChunk([&input, &bounds, &offsets, output](const std::size_t i) {
+		writeRuns(input.substr(bounds[i], bounds[i + 1] - bounds[i]), output + offsets[i]);
+	});
+
+	m_length = offsets.back();
+}
+
+
+
+// --- LookAndSay::reserveNext() ---
+// Grows the next buffer to at least size bytes, keeping its content
+void LookAndSay::reserveNext(const std::size_t size)
+{
+	auto& buffer {m_buffers[m_current ^ 1]};
+	if (buffer.size() < size) {
+		buffer.resize(size + size / 4);
+	}
+}
+
+
 
-			count = 1;
-			buffer = *i;
+// --- decomposeElements() ------------------
+// Splits sequence into a compound of elements, returns false if that is not possible
+bool decomposeElements(std::string_view sequence, counts_t& counts)
+{
+	constexpr elementId_t no_element {element_count};
+	const auto length {sequence.length()};
+
+	// lastElement[i] is the element ending at position i of a possible split of the first i digits
+	std::vector<elementId_t> lastElement(length + 1, no_element);
+	for (strViewSize_t i {0}; i < length; ++i) {
+		if (i > 0 && lastElement[i] == no_element) {
+			continue;
+		}
+
+		for (std::size_t id {0}; id < element_count; ++id) {
+			const auto element {elements[id].sequence};
+			const auto end {i + element.length()};
+			if (end <= length && lastElement[end] == no_element && sequence.compare(i, element.length(), element) == 0) {
+				lastElement[end] = static_cast<elementId_t>(id);
+			}
 		}
 	}
-	result.append(std::to_string(count));
-	result.push_back(buffer);
 
+	if (lastElement[length] == no_element) {
+		return false;
+	}
+
+	counts.fill(0);
+	for (auto i {length}; i > 0; i -= elements[lastElement[i]].sequence.length()) {
+		++counts[lastElement[i]];
+	}
+	return true;
+}
+
+
+
+//=== Class AudioactiveDecay =================================================
+class AudioactiveDecay final {
+public:
+// Constructors / destructor
+	AudioactiveDecay() = delete;
+	AudioactiveDecay(const AudioactiveDecay&) = delete;
+	AudioactiveDecay(AudioactiveDecay&&) = delete;
+	~AudioactiveDecay() = default;
+
+	explicit AudioactiveDecay(std::string_view sequence);
+
+
+// Operators
+	AudioactiveDecay& operator=(const AudioactiveDecay&) = delete;
+	AudioactiveDecay& operator=(AudioactiveDecay&&) = delete;
+
+
+// Getter
+	bool isDecomposed() const;				// false, if the sequence does not decay into the elements of the table
+	length_t getLength(int steps) const;	// throws, if not decomposed or the length does not fit into length_t
+
+
+private:
+// Functions
+	length_t calculateLength(int steps) const;
+	bool verifyDecomposition(std::string_view sequence) const;
+
+
+// Variables
+	std::vector<length_t> m_lengths {};		// lengths of the steps before the sequence has decayed into elements
+	counts_t m_counts {};					// number of each element at step m_lengths.size()
+	bool m_isDecomposed {false};
+};
+
+
+
+// --- AudioactiveDecay::AudioactiveDecay() ---
+AudioactiveDecay::AudioactiveDecay(std::string_view sequence)
+{
+	EXPECT(!sequence.empty(), "Sequence must not be empty.");
+
+	// evolve the string until it is a compound of elements
+	LookAndSay buffer {sequence, 0};	// grows with the steps needed, often the sequence is decomposed at once
+	while (!decomposeElements(buffer.getSequence(), m_counts) || !verifyDecomposition(buffer.getSequence())) {
+		if (m_lengths.size() >= decompose_limit) {
+			return;
+		}
+
+		m_lengths.push_back(buffer.getLength());
+		buffer.step();
+	}
+	m_isDecomposed = true;
+}
+
+
+
+// --- AudioactiveDecay::isDecomposed() ---
+bool AudioactiveDecay::isDecomposed() const
+{
+	return m_isDecomposed;
+}
+
+
+
+// --- AudioactiveDecay::getLength() ---
+length_t AudioactiveDecay::getLength(const int steps) const
+{
+	EXPECT(m_isDecomposed, "Sequence does not decay into common elements.");
+	return calculateLength(steps);
+}
+
+
+
+// --- AudioactiveDecay::calculateLength() ---
+length_t AudioactiveDecay::calculateLength(const int steps) const
+{
+	EXPECT(steps >= 0, "Number of steps must not be negative.");
+	const auto offset {static_cast<int>(m_lengths.size())};
+	if (steps < offset) {
+		return m_lengths[static_cast<std::size_t>(steps)];
+	}
+
+	constexpr auto overflow_error {"Length does not fit into 64 bit."};    // at about 160 steps
+	counts_t counts {m_counts};
+	for (int step {offset}; step < steps; ++step) {
+		counts_t next {};
+		for (std::size_t id {0}; id < element_count; ++id) {
+			const auto& element {elements[id]};
+			for (std::size_t i {0}; i < element.decayCount; ++i) {
+				auto& count {next[element.decay[i]]};
+				EXPECT(!__builtin_add_overflow(count, counts[id], &count), overflow_error);
+			}
+		}
+		counts = next;
+	}
+
+	length_t result {0};
+	for (std::size_t id {0}; id < element_count; ++id) {
+		length_t length {};
+		EXPECT(!__builtin_mul_overflow(counts[id], elements[id].sequence.length(), &length), overflow_error);
+		EXPECT(!__builtin_add_overflow(result, length, &result), overflow_error);
+	}
 	return result;
 }
 
 
 
+// --- AudioactiveDecay::verifyDecomposition() ---
+// Compares the first steps of m_counts with the string based path, as only a real split never interacts again
+bool AudioactiveDecay::verifyDecomposition(std::string_view sequence) const
+{
+	const auto offset {static_cast<int>(m_lengths.size())};
+	LookAndSay buffer {sequence, verify_steps};
+	for (int step {1}; step <= verify_steps; ++step) {
+		buffer.step();
+		if (buffer.getLength() != calculateLength(offset + step)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+
+
 } /* anonymous namespace */
 
 
@@ -85,20 +578,26 @@ void Day10::solve()
 		m_IO.printFileValid();
 
 
-		std::string buffer {input};
-		constexpr int loop_end_part1 {40};
-		constexpr int loop_end_part2 {50};
-		int i {0};
+		constexpr int steps_part1 {40};
+		constexpr int steps_part2 {50};
 
-		for (; i < loop_end_part1; ++i) {
-			buffer = lookAndTell(buffer);
+		LookAndSay sequence {input, steps_part1, true};
+		for (int i {0}; i < steps_part1; ++i) {
+			sequence.step();
 		}
-		m_IO.printSolution(buffer.length(), EPart::Part1);
+		m_IO.printSolution(sequence.getLength(), EPart::Part1);
 
-		for (; i < loop_end_part2; ++i) {
-			buffer = lookAndTell(buffer);
+		// part 1 checks the decomposition, without one part 2 is still short enough to be generated
+		const AudioactiveDecay decay {input};
+		if (decay.isDecomposed()) {
+			EXPECT(sequence.getLength() == decay.getLength(steps_part1), "Decomposition does not match the sequence.");
+			m_IO.printSolution(decay.getLength(steps_part2), EPart::Part2);
+		} else {
+			for (int i {steps_part1}; i < steps_part2; ++i) {
+				sequence.step();
+			}
+			m_IO.printSolution(sequence.getLength(), EPart::Part2);
 		}
-		m_IO.printSolution(buffer.length(), EPart::Part2);
 
 
 	} catch (const std::exception& err) {
@@ -31,7 +31,10 @@ Your puzzle answer was vzcaabcc. */
 #include "Day11.h"
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
 #include <string>
+#include <vector>
 
 #include "../aoc/BasicDefinitions.h"
 #include "../aoc/BasicIO.h"
@@ -46,6 +49,111 @@ namespace {
 
 //=== Constants ==============================================================
 constexpr strSize_t password_length {8};
+constexpr int letter_count {26};
+constexpr int straight_needed {3};
+constexpr int pairs_needed {2};
+
+
+
+//=== Types ==================================================================
+/* The rules only depend on a small state, so the password can be checked letter by letter and it is possible
+to know in advance, whether a prefix can still be completed to a valid password. */
+struct SRuleState {
+	int last {letter_count};	// previous letter, letter_count at the start
+	int straight {0};			// length of the increasing straight ending at last (capped at straight_needed)
+	bool hasStraight {false};	// straight_needed has been reached
+	int pairs {0};				// non-overlapping pairs (capped at pairs_needed)
+	bool lastInPair {false};	// last is the second letter of a pair and can not start another one
+};
+
+constexpr int state_count {(letter_count + 1) * straight_needed * 2 * (pairs_needed + 1) * 2};
+using completionTable_t = std::array<std::array<bool, state_count>, password_length + 1>;
+
+
+
+//=== Functions ==============================================================
+// --- isAllowed() ------------------
+bool isAllowed(const int letter)
+{
+	return letter != 'i' - 'a' && letter != 'l' - 'a' && letter != 'o' - 'a';
+}
+
+
+
+// --- getIndex() ------------------
+int getIndex(const SRuleState& state)
+{
+	int result {state.last};
+	result = result * straight_needed + state.straight - (state.straight > 0 ? 1 : 0);
+	result = result * 2 + (state.hasStraight ? 1 : 0);
+	result = result * (pairs_needed + 1) + state.pairs;
+	return result * 2 + (state.lastInPair ? 1 : 0);
+}
+
+
+
+// --- addLetter() ------------------
+// State after appending an allowed letter
+SRuleState addLetter(const SRuleState& state, const int letter)
+{
+	SRuleState result {};
+	result.last = letter;
+	result.straight = (state.last + 1 == letter) ? std::min(state.straight + 1, straight_needed) : 1;
+	result.hasStraight = state.hasStraight || result.straight == straight_needed;
+
+	const bool isPair {state.last == letter && !state.lastInPair};
+	result.pairs = isPair ? std::min(state.pairs + 1, pairs_needed) : state.pairs;
+	result.lastInPair = isPair;
+	return result;
+}
+
+
+
+// --- isComplete() ------------------
+bool isComplete(const SRuleState& state)
+{
+	return state.hasStraight && state.pairs == pairs_needed;
+}
+
+
+
+// --- getCompletionTable() ------------------
+// table[n][state] is true, if n more letters can turn state into a valid password
+const completionTable_t& getCompletionTable()
+{
+	static const completionTable_t table {[]() {
+		// all reachable states, so every index is filled
+		std::vector<SRuleState> states {};
+		for (int last {0}; last <= letter_count; ++last) {
+			for (int straight {last < letter_count ? 1 : 0}; straight <= (last < letter_count ? straight_needed : 0); ++straight) {
+				for (const bool hasStraight : {false, true}) {
+					for (int pairs {0}; pairs <= pairs_needed; ++pairs) {
+						for (const bool lastInPair : {false, true}) {
+							states.push_back(SRuleState {last, straight, hasStraight, pairs, lastInPair});
+						}
+					}
+				}
+			}
+		}
+
+		completionTable_t result {};
+		for (const auto& state : states) {
+			result[0][static_cast<std::size_t>(getIndex(state))] = isComplete(state);
+		}
+		for (strSize_t remaining {1}; remaining <= password_length; ++remaining) {
+			for (const auto& state : states) {
+				bool possible {false};
+				for (int letter {0}; letter < letter_count && !possible; ++letter) {
+					possible = isAllowed(letter) && result[remaining - 1][static_cast<std::size_t>(getIndex(addLetter(state, letter)))];
+				}
+				result[remaining][static_cast<std::size_t>(getIndex(state))] = possible;
+			}
+		}
+		return result;
+	}()};
+
+	return table;
+}
 
 
 
@@ -77,13 +185,33 @@ public:
 
 
 	// --- operator++() ---
+	// Next valid password: keeps the longest possible prefix, increments the letter behind it
+	// and completes the rest with the smallest letters, which still allow a valid password
 	Password& operator++()
 	{
-		do {
-			incPassword(password_length - 1);
-		} while (!isValid());
+		const auto& canComplete {getCompletionTable()};
+
+		// states of all prefixes, which contain only allowed letters
+		std::array<SRuleState, password_length + 1> states {};
+		strSize_t validPrefix {0};
+		while (validPrefix < password_length && isAllowed(getLetter(validPrefix))) {
+			states[validPrefix + 1] = addLetter(states[validPrefix], getLetter(validPrefix));
+			++validPrefix;
+		}
 
-		return *this;
+		for (auto index {std::min(validPrefix, password_length - 1) + 1}; index-- > 0;) {
+			for (int letter {getLetter(index) + 1}; letter < letter_count; ++letter) {
+				const auto state {addLetter(states[index], letter)};
+				if (isAllowed(letter) && canComplete[password_length - index - 1][static_cast<std::size_t>(getIndex(state))]) {
+					setLetter(index, letter);
+					states[index + 1] = state;
+					completeFrom(index + 1, states[index + 1]);
+					return *this;
+				}
+			}
+		}
+
+		THROW_ERROR("There is no valid password left.");
 	}
 
 
@@ -96,81 +224,35 @@ public:
 
 private:
 // Functions
-	// --- incPassword() ---
-	void incPassword(const strSize_t index)
+	// --- getLetter() ---
+	int getLetter(const strSize_t index) const
 	{
-		EXPECT(index < password_length, "Index out of bounds.");
-
-		switch (m_data[index]) {
-		case 'h':
-		case 'k':
-		case 'n':	// i, o and l are not allowed
-			m_data[index] += 2;
-			break;
-
-		case 'z':	// roll over
-			m_data[index] = 'a';
-			if (index > 0) {
-				incPassword(index - 1);
-			}
-			break;
-
-		default:
-			++m_data[index];
-			break;
-		}
+		return m_data[index] - 'a';
 	}
 
 
-	// --- isValid() ---
-	bool isValid() const
+	// --- setLetter() ---
+	void setLetter(const strSize_t index, const int letter)
 	{
-		const auto isStraight = [&]() {
-			constexpr int straight_needed {3};
-
-			char buffer {m_data[0]};
-			int count {1};
-
-			for (const auto chr : m_data) {
-				count = (buffer + 1 == chr) ? count + 1 : 1;
-				buffer = chr;
-				if (count == straight_needed) {
-					return true;
-				}
-			}
-
-			return false;
-		};
-
-
-		const auto isDouble = [&]() {
-			char buffer {m_data[0]};
-			int count {0};
-			strSize_t i {1};
-
-			while (i < password_length) {
-				if (buffer == m_data[i]) {
-					++count;
-					++i;
-				}
+		m_data[index] = static_cast<char>('a' + letter);
+	}
 
-				if (count > 1) {
-					return true;
-				}
 
-				if (i < password_length) {
-					buffer = m_data[i];
-				}
+	// --- completeFrom() ---
+	// Fills the password from index with the smallest letters, state must be completable
+	void completeFrom(strSize_t index, SRuleState state)
+	{
+		const auto& canComplete {getCompletionTable()};
 
-				++i;
+		for (; index < password_length; ++index) {
+			int letter {0};
+			while (!isAllowed(letter) || !canComplete[password_length - index - 1][static_cast<std::size_t>(getIndex(addLetter(state, letter)))]) {
+				++letter;
 			}
 
-			return false;
-		};
-
-
-
-		return isStraight() && isDouble();
+			setLetter(index, letter);
+			state = addLetter(state, letter);
+		}
 	}
 
 
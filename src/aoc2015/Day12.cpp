@@ -31,8 +31,9 @@ Your puzzle answer was 96852. */
 //=== Include ================================================================
 #include "Day12.h"
 
-#include <string>
+#include <cctype>
 #include <string_view>
+#include <vector>
 
 #include "../aoc/BasicDefinitions.h"
 #include "../aoc/BasicIO.h"
@@ -45,100 +46,202 @@ namespace {
 
 
 
-//=== Functions ==============================================================
-// --- countNumbers() ------------------
-int countNumbers(std::string_view input)
+//=== Types ==================================================================
+using sum_t = long long;
+
+
+
+//=== Class JsonAbacus =======================================================
+/* Scans a JSON document in one pass, it can be fed in chunks of any size. Every open object or array has its own
+subtotal, which is added to its parent on close, unless the object has a property with the value "red". */
+class JsonAbacus final {
+public:
+// Constructors / destructor
+	JsonAbacus() = default;
+	JsonAbacus(const JsonAbacus&) = delete;
+	JsonAbacus(JsonAbacus&&) = delete;
+	~JsonAbacus() = default;
+
+
+// Operators
+	JsonAbacus& operator=(const JsonAbacus&) = delete;
+	JsonAbacus& operator=(JsonAbacus&&) = delete;
+
+
+// Getter
+	sum_t getSum() const;			// all numbers
+	sum_t getSumWithoutRed() const;	// without objects having a property "red"
+
+
+// Functions
+	void feed(std::string_view chunk);
+	void finish();
+
+
+private:
+// Types
+	struct SContainer {
+		sum_t sum {0};				// numbers not in a red object
+		bool isObject {false};
+		bool isRed {false};
+	};
+
+
+// Functions
+	void addNumber();
+	void scanString(const char chr);
+
+
+// Constants
+	static constexpr std::string_view red {"red"};
+	static constexpr strViewSize_t no_match {red.length() + 1};	// string can not be "red" anymore
+
+
+// Variables
+	std::vector<SContainer> m_containers {SContainer {}};	// open containers, the first is the document itself
+	sum_t m_sum {0};										// all numbers
+
+	// state, which may continue in the next chunk
+	bool m_inNumber {false};
+	bool m_isNegative {false};
+	sum_t m_number {0};
+
+	bool m_inString {false};
+	bool m_isEscaped {false};
+	bool m_isValue {false};				// string is the value of an object property
+	strViewSize_t m_redMatched {0};		// matched characters of red, no_match if impossible
+
+	bool m_afterColon {false};			// last structural character was ':'
+};
+
+
+
+// --- JsonAbacus::getSum() ---
+sum_t JsonAbacus::getSum() const
 {
-	const auto loop_end(input.cend());
-	int result {0};
-
-	// Warning: i may advance inside of the loop
-	// Assuming input does not end with a number, should end with closed brace
-	for (auto i {input.cbegin()}, j {i}; i != loop_end; std::advance(i, 1)) {
-		if (std::isdigit(*i) || *i == '-') {
-			j = std::next(i);
-			while (std::isdigit(*j)) {
-				std::advance(j, 1);
-			}
-			result += std::stoi(std::string(i, j));
-			i = j;
-		}
-	}
+	return m_sum;
+}
+
+
 
-	return result;
+// --- JsonAbacus::getSumWithoutRed() ---
+sum_t JsonAbacus::getSumWithoutRed() const
+{
+	return m_containers.front().sum;
 }
 
 
 
-// --- findOpenBrace() ------------------
-auto findOpenBrace(std::string_view input, strViewSize_t index)
+// --- JsonAbacus::feed() ---
+void JsonAbacus::feed(std::string_view chunk)
 {
-	strViewSize_t pos_open_brace {};
-	strViewSize_t pos_close_brace {};
-	int count {1};
-
-	do {
-		pos_open_brace = input.find_last_of('{', index);
-		pos_close_brace = input.find_last_of('}', index);
-
-		if ((pos_open_brace < pos_close_brace) && (pos_close_brace != std::string_view::npos)) {
-			++count;
-			index = pos_close_brace - 1;
-		} else {
-			--count;
-			index = pos_open_brace - 1;
+	for (const auto chr : chunk) {
+		if (m_inString) {
+			scanString(chr);
+			continue;
 		}
-	} while (count > 0);
 
-	return pos_open_brace;
-}
+		if (std::isdigit(static_cast<unsigned char>(chr))) {
+			m_inNumber = true;
+			m_number = m_number * 10 + (chr - '0');
+			continue;
+		}
+		if (m_inNumber) {
+			addNumber();
+		}
 
+		switch (chr) {
+		case '-':
+			m_inNumber = true;
+			m_isNegative = true;
+			break;
+
+		case '"':
+			m_inString = true;
+			m_isValue = m_afterColon && m_containers.back().isObject;
+			m_redMatched = 0;
+			break;
+
+		case '{':
+		case '[':
+			m_containers.push_back(SContainer {0, chr == '{', false});
+			break;
+
+		case '}':
+		case ']': {
+			EXPECT(m_containers.size() > 1, invalid_input_file_data);
+			const auto container {m_containers.back()};
+			m_containers.pop_back();
+			if (!container.isRed) {
+				m_containers.back().sum += container.sum;
+			}
+			break;
+		}
 
+		default:
+			break;
+		}
 
-// --- Day12::findCloseBrace() ------------------
-auto findCloseBrace(std::string_view input, strViewSize_t index)
-{
-	strViewSize_t pos_open_brace {};
-	strViewSize_t pos_close_brace {};
-	int count {1};
-
-	do {
-		pos_open_brace = input.find('{', index);
-		pos_close_brace = input.find('}', index);
-
-		if ((pos_open_brace < pos_close_brace) && (pos_open_brace != std::string_view::npos)) {
-			++count;
-			index = pos_open_brace + 1;
-		} else {
-			--count;
-			index = pos_close_brace + 1;
+		if (!std::isspace(static_cast<unsigned char>(chr))) {
+			m_afterColon = chr == ':';
 		}
-	} while (count > 0);
+	}
+}
+
+
 
-	return pos_close_brace;
+// --- JsonAbacus::finish() ---
+// Call after the last chunk
+void JsonAbacus::finish()
+{
+	if (m_inNumber) {
+		addNumber();
+	}
+	EXPECT(!m_inString && m_containers.size() == 1, invalid_input_file_data);
 }
 
 
 
-// --- removeRed() ------------------
-std::string removeRed(std::string_view input)
+// --- JsonAbacus::addNumber() ---
+void JsonAbacus::addNumber()
 {
-	constexpr std::string_view val_red {":\"red\""};
+	const auto number {m_isNegative ? -m_number : m_number};
+	m_sum += number;
+	m_containers.back().sum += number;
+
+	m_inNumber = false;
+	m_isNegative = false;
+	m_number = 0;
+}
 
-	std::string result {input};
-	auto pos_red {input.find(val_red)};
-	strViewSize_t pos_open_brace {};
-	strViewSize_t pos_close_brace {};
 
-	while (pos_red != std::string_view::npos) {
-		pos_open_brace = findOpenBrace(result, pos_red);
-		pos_close_brace = findCloseBrace(result, pos_red);
-		result = result.erase(pos_open_brace, pos_close_brace - pos_open_brace + 1);
 
-		pos_red = result.find(val_red);
+// --- JsonAbacus::scanString() ---
+void JsonAbacus::scanString(const char chr)
+{
+	if (m_isEscaped) {
+		m_isEscaped = false;
+		m_redMatched = no_match;
+		return;
 	}
 
-	return result;
+	switch (chr) {
+	case '\\':
+		m_isEscaped = true;
+		break;
+
+	case '"':
+		m_inString = false;
+		m_afterColon = false;
+		if (m_isValue && m_redMatched == red.length()) {
+			m_containers.back().isRed = true;
+		}
+		break;
+
+	default:
+		m_redMatched = (m_redMatched < red.length() && red[m_redMatched] == chr) ? m_redMatched + 1 : no_match;
+		break;
+	}
 }
 
 
@@ -152,11 +255,13 @@ std::string removeRed(std::string_view input)
 void Day12::solve()
 {
 	try {
-		const std::string input {m_IO.getInputString()};
+		JsonAbacus abacus {};
+		abacus.feed(m_IO.getInputData());
+		abacus.finish();
 		m_IO.printFileValid();
 
-		m_IO.printSolution(countNumbers(input), EPart::Part1);
-		m_IO.printSolution(countNumbers(removeRed(input)), EPart::Part2);
+		m_IO.printSolution(abacus.getSum(), EPart::Part1);
+		m_IO.printSolution(abacus.getSumWithoutRed(), EPart::Part2);
 
 
 	} catch (const std::exception& err) {
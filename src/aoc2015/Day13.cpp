@@ -49,17 +49,16 @@ Your puzzle answer was 725. */
 #include "Day13.h"
 
 #include <algorithm>
-#include <fstream>
-#include <iostream>
-#include <iterator>
+#include <cstddef>
 #include <limits>
-#include <list>
-#include <stdexcept>
-#include <string>
+#include <string_view>
 #include <utility>
+#include <vector>
 
 #include "../aoc/BasicDefinitions.h"
 #include "../aoc/BasicIO.h"
+#include "../aoc/InputScanner.h"
+#include "../aoc/PermutationSearch.h"
 #include "../aoc/TemplateContainer.h"
 
 
@@ -72,11 +71,15 @@ namespace {
 
 //=== Types ==================================================================
 using happiness_t = int;
-using guestPair_t = std::pair<std::string, std::string>;
-using locationListData_t = std::list<std::string>;
+using guestPair_t = std::pair<std::string_view, std::string_view>;
 
-using happinessMap_t = DoubleKeyMap<std::string, happiness_t>;
-using guestList_t = UniqueList<std::string>;
+using happinessMap_t = WeightMatrix<happiness_t>;
+using seatingSearch_t = PermutationSearch<happiness_t>;
+
+
+
+//=== Constants ==============================================================
+constexpr std::size_t max_table_guests {20};	// the table of paths needs 2^(n-1) * (n-1) entries, more are searched
 
 
 
@@ -88,74 +91,206 @@ struct SInputData {
 
 
 
-struct SMapAndList {// happinessMap and guestList are created together
-	happinessMap_t map {};
-	guestList_t list {};
-};
-
-
-
 //=== Functions ==============================================================
 // --- readInputData() ---
-SInputData readInputData(std::ifstream& file)
+// Reads lines like "Alice would gain 54 happiness units by sitting next to Bob."
+SInputData readInputData(std::string_view line)
 {
+	TokenScanner scanner {line};
 	SInputData result {};
-	std::string buffer {};
-	file >> result.guestPair.first;
-	constexpr auto would_width {std::string_view("would ").length()};
-	file.ignore(would_width);
-	file >> buffer;
 
-	file >> result.happiness;
-	EXPECT(!file.fail(), invalid_input_file_data);
+	result.guestPair.first = scanner.nextToken();
+	scanner.skip("would");
+	const auto change {scanner.nextToken()};
+	result.happiness = scanner.nextInt<happiness_t>();
 
-	if (buffer == "lose") {
+	if (change == "lose") {
 		result.happiness *= -1;
-	} else if (buffer != "gain") {
+	} else if (change != "gain") {
 		THROW_ERROR(invalid_input_file_data);
 	}
 
-	constexpr auto skip_width {std::string_view("happiness units by sitting next to ").length()};
-	file.ignore(skip_width);
-	file >> result.guestPair.second;
-	result.guestPair.second.pop_back(); // remove dot
+	scanner.skip("happiness units by sitting next to");
+	result.guestPair.second = scanner.nextToken();
+	EXPECT(result.guestPair.second.back() == '.' && scanner.isEnd(), invalid_input_file_data);
+	result.guestPair.second.remove_suffix(1); // remove dot
 
 	return result;
 }
 
 
 
-// --- readMapAndList() ---
-SMapAndList readMapAndList(std::ifstream file)
+// --- readHappinessMap() ---
+// A guest gets an id the first time he is mentioned, unset pairs are 0
+happinessMap_t readHappinessMap(std::string_view input)
 {
-	SMapAndList result {};
+	happinessMap_t result {false};
 
-	while (!file.eof()) {
-		SInputData buffer {readInputData(file)};
-		result.map.insert(buffer.guestPair, buffer.happiness);
-		result.list.addData(buffer.guestPair.first);
-		result.list.addData(buffer.guestPair.second);
+	for (const auto line : Lines {input}) {
+		if (line.empty()) {
+			continue;
+		}
+
+		const SInputData buffer {readInputData(line)};
+		EXPECT(buffer.guestPair.first != buffer.guestPair.second, invalid_input_file_data);
+		result.setWeight(buffer.guestPair.first, buffer.guestPair.second, buffer.happiness);
 	}
 
+	EXPECT(result.size() > 0, invalid_input_file_data);
 	return result;
 }
 
 
 
-// --- getHappiness() ---
-auto getHappiness(const SMapAndList& data)
+//=== Class SeatingSolver ====================================================
+/* Held-Karp for a cycle: guest 0 is fixed as first seat, as rotations of a table are equal. The two happiness values
+of a pair are folded into one symmetric weight, so a table read clockwise is as happy as read counterclockwise.
+Therefore each table is two paths from guest 0 to the same guest through disjoint sets of the other guests, and both
+halves can be read from the same table of paths. Only paths through up to half of the guests are calculated. */
+class SeatingSolver {
+public:
+// Constructors / destructor
+	SeatingSolver() = delete;
+	SeatingSolver(const SeatingSolver&) = delete;
+	SeatingSolver(SeatingSolver&&) = delete;
+	~SeatingSolver() = default;
+
+
+	// --- SeatingSolver() ---
+	explicit SeatingSolver(const happinessMap_t& map) : m_size {map.size()}, m_pairs(m_size * m_size, 0)
+	{
+		EXPECT(m_size > 0, invalid_input_file_data);
+		EXPECT(m_size <= max_table_guests, "Too many guests.");
+
+		for (std::size_t first {0}; first < m_size; ++first) {
+			for (std::size_t second {0}; second < m_size; ++second) {
+				if (first != second) {
+					m_pairs[first * m_size + second] = map(first, second) + map(second, first);
+				}
+			}
+		}
+	}
+
+
+// Operators
+	SeatingSolver& operator=(const SeatingSolver&) = delete;
+	SeatingSolver& operator=(SeatingSolver&&) = delete;
+
+
+// Functions
+	// --- getMaxHappiness() ---
+	happiness_t getMaxHappiness() const
+	{
+		if (m_size == 1) {
+			return 0;
+		}
+
+		// guests 1 .. m_size - 1 are bit 0 .. others - 1 of a set
+		const std::size_t others {m_size - 1};
+		const std::size_t sets {std::size_t {1} << others};
+		const std::size_t allOthers {sets - 1};
+
+		// a table is a path through a set of size half and one through the rest and the common last guest
+		const std::size_t half {others / 2 + 1};
+
+		// paths[set * others + last]: happiest path from guest 0 through all guests of set, which ends at last
+		std::vector<happiness_t> paths(sets * others, 0);
+		for (std::size_t set {1}; set < sets; ++set) {
+			const auto setSize {getSetSize(set)};
+			if (setSize > half) {
+				continue;
+			}
+
+			for (std::size_t last {0}; last < others; ++last) {
+				const std::size_t lastBit {std::size_t {1} << last};
+				if ((set & lastBit) == 0) {
+					continue;
+				}
+
+				auto& path {paths[set * others + last]};
+				if (setSize == 1) {
+					path = getPair(0, last + 1);
+					continue;
+				}
+
+				const std::size_t previousSet {set ^ lastBit};
+				path = std::numeric_limits<happiness_t>::lowest();
+				for (std::size_t previous {0}; previous < others; ++previous) {
+					if ((previousSet & (std::size_t {1} << previous)) != 0) {
+						path = std::max(path, paths[previousSet * others + previous] + getPair(previous + 1, last + 1));
+					}
+				}
+			}
+		}
+
+		happiness_t result {std::numeric_limits<happiness_t>::lowest()};
+		for (std::size_t set {1}; set < sets; ++set) {
+			if (getSetSize(set) != half) {
+				continue;
+			}
+
+			for (std::size_t last {0}; last < others; ++last) {
+				const std::size_t lastBit {std::size_t {1} << last};
+				if ((set & lastBit) != 0) {
+					const std::size_t otherHalf {(allOthers ^ set) | lastBit};
+					result = std::max(result, paths[set * others + last] + paths[otherHalf * others + last]);
+				}
+			}
+		}
+
+		return result;
+	}
+
+
+private:
+// Functions
+	// --- getPair() ---
+	happiness_t getPair(const std::size_t first, const std::size_t second) const
+	{
+		return m_pairs[first * m_size + second];
+	}
+
+
+	// --- getSetSize() ---
+	static std::size_t getSetSize(std::size_t set)
+	{
+		std::size_t result {0};
+		for (; set != 0; set &= set - 1) {
+			++result;
+		}
+		return result;
+	}
+
+
+// Variables
+	const std::size_t m_size;					// number of guests
+	std::vector<happiness_t> m_pairs;			// happiness of both neighbours, 0 for the same guest
+};
+
+
+
+// --- searchMaxHappiness() ---
+// Branch-and-bound for more guests than the table of SeatingSolver can hold
+happiness_t searchMaxHappiness(const happinessMap_t& map)
 {
-	const auto loop_end {std::prev(data.list.cend())};
-	happiness_t result {data.map.find(std::make_pair(*data.list.cbegin(), *loop_end)) + data.map.find(
-			std::make_pair(*loop_end, *data.list.cbegin()))};
+	// the happiness of both neighbours, as each pair of neighbours is only counted once
+	const auto getPair {[&map](const std::size_t first, const std::size_t second) {
+		return (first == second) ? 0 : map(first, second) + map(second, first);
+	}};
 
-	for (auto i {data.list.cbegin()}, j {i}; i != loop_end; i = j) {
-		j = std::next(i);
-		result += data.map.find(std::make_pair(*i, *j));
-		result += data.map.find(std::make_pair(*j, *i));
-	};
+	seatingSearch_t seating {map.size(), [&getPair](const auto first, const auto second) {
+		return getPair(static_cast<std::size_t>(first), static_cast<std::size_t>(second));
+	}, true};
 
-	return result;
+	return seating.find(seatingSearch_t::EGoal::maximum);
+}
+
+
+
+// --- getMaxHappiness() ---
+happiness_t getMaxHappiness(const happinessMap_t& map)
+{
+	return (map.size() <= max_table_guests) ? SeatingSolver {map}.getMaxHappiness() : searchMaxHappiness(map);
 }
 
 
@@ -169,28 +304,14 @@ auto getHappiness(const SMapAndList& data)
 void Day13::solve()
 {
 	try {
-		SMapAndList input {readMapAndList(m_IO.getInputFile())};
+		happinessMap_t happiness {readHappinessMap(m_IO.getInputData())};
 		m_IO.printFileValid();
 
-		const auto calculateHappiness = [&]() {
-			happiness_t maxHappiness {std::numeric_limits<happiness_t>::min()};
-			do {
-				const auto happiness {getHappiness(input)};
-				maxHappiness = std::max(maxHappiness, happiness);
-			} while (input.list.nextPermutation(1));   // at a circular table it should not matter where we start counting
-			return maxHappiness;
-		};
-
-		m_IO.printSolution(calculateHappiness(), EPart::Part1);
-
-
-		const std::string me {"me"};
-		std::for_each(input.list.cbegin(), input.list.cend(), [&](const auto& data) {
-			input.map.insert(std::make_pair(me, data), 0);
-		});
-		input.list.addData(me);
+		m_IO.printSolution(getMaxHappiness(happiness), EPart::Part1);
 
-		m_IO.printSolution(calculateHappiness(), EPart::Part2);
+		const auto guests {happiness.size()};
+		EXPECT(happiness.addName("me") == guests, invalid_input_file_data);	// I am nobody's neighbour yet, so all pairs are 0
+		m_IO.printSolution(getMaxHappiness(happiness), EPart::Part2);
 
 	} catch (const std::exception& err) {
 		m_IO.printError(err.what());
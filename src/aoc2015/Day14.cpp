@@ -40,14 +40,18 @@ Your puzzle answer was 1102. */
 #include "Day14.h"
 
 #include <algorithm>
-#include <fstream>
-#include <iostream>
-#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <queue>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include "../aoc/BasicDefinitions.h"
 #include "../aoc/BasicIO.h"
+#include "../aoc/InputScanner.h"
 
 
 
@@ -59,163 +63,226 @@ namespace {
 
 //=== Types ==================================================================
 using speed_t = unsigned int;
-using distance_t = unsigned int;
-using time_t = unsigned int;
+using distance_t = std::uint64_t;
+using seconds_t = std::uint64_t;
+using score_t = std::uint64_t;
 
 
 
-//=== Class Reindeer ========================================================
+//=== Constants ==============================================================
+constexpr seconds_t race_time {2503};
+
+
+
+//=== Class Reindeer =========================================================
+// A reindeer always repeats the same cycle of flying and resting, so its position is known for each time
 class Reindeer {
 public:
-// Getter
-	// --- getTraveledDistance() ---
-	auto getTraveledDistance() const
+// Constructors / destructor
+	Reindeer() = delete;
+	Reindeer(const Reindeer&) = delete;
+	Reindeer(Reindeer&&) = delete;
+	~Reindeer() = default;
+
+
+	// --- Reindeer() ---
+	// Reads lines like "Comet can fly 14 km/s for 10 seconds, but then must rest for 127 seconds."
+	explicit Reindeer(std::string_view line)
 	{
-		return m_traveledDistance;
+		TokenScanner scanner {line};
+		scanner.nextToken();	// name
+		scanner.skip("can fly");
+		m_speed = scanner.nextInt<speed_t>();
+		scanner.skip("km/s for");
+		m_flyTime = scanner.nextInt<seconds_t>();
+		scanner.skip("seconds, but then must rest for");
+		m_restTime = scanner.nextInt<seconds_t>();
+		scanner.skip("seconds.");
+		EXPECT(scanner.isEnd() && m_speed > 0 && m_flyTime > 0, invalid_input_file_data);
 	}
 
 
-// Functions
-	// --- fly() ---
-	void fly()
+// Operators
+	Reindeer& operator=(const Reindeer&) = delete;
+	Reindeer& operator=(Reindeer&&) = delete;
+
+
+	// --- operator==() ---
+	// Equal reindeer are always at the same position
+	bool operator==(const Reindeer& other) const
 	{
-		if (m_flyTime > 0) {
-			--m_flyTime;
-			m_traveledDistance += m_maxSpeed;
-		} else {
-			--m_restTime;
-			if (m_restTime == 0) {
-				m_restTime = m_maxRestTime;
-				m_flyTime = m_maxFlyTime;
-			}
-		}
+		return m_speed == other.m_speed && m_flyTime == other.m_flyTime && m_restTime == other.m_restTime;
 	}
 
 
-	// --- reset() ---
-	void reset()
+	// --- operator!=() ---
+	bool operator!=(const Reindeer& other) const
 	{
-		m_flyTime = m_maxFlyTime;
-		m_restTime = m_maxRestTime;
-		m_traveledDistance = 0;
-		score = 0;
+		return !(*this == other);
 	}
 
 
-// Variables
-	unsigned int score {0}; // TODO: own vector to track score
+// Getter
+	// --- getDistance() ---
+	// Distance after time seconds
+	distance_t getDistance(const seconds_t time) const
+	{
+		const seconds_t cycles {time / getCycleTime()};
+		const seconds_t rest {time % getCycleTime()};
+		return m_speed * (cycles * m_flyTime + std::min(rest, m_flyTime));
+	}
 
 
-// Friends
-	friend Reindeer readReindeer(std::ifstream&);
+	// --- getTimeToReach() ---
+	// First time the reindeer is at least at distance, inverse of getDistance()
+	seconds_t getTimeToReach(const distance_t distance) const
+	{
+		if (distance == 0) {
+			return 0;
+		}
+
+		const distance_t cycleDistance {m_speed * m_flyTime};
+		const seconds_t cycles {(distance - 1) / cycleDistance};			// the last cycle is not complete
+		const distance_t rest {distance - cycles * cycleDistance};		// 1 .. cycleDistance
+		return cycles * getCycleTime() + (rest + m_speed - 1) / m_speed;
+	}
 
 
 private:
+// Functions
+	// --- getCycleTime() ---
+	seconds_t getCycleTime() const
+	{
+		return m_flyTime + m_restTime;
+	}
+
+
 // Variables
-	std::string m_name {""};
-	speed_t m_maxSpeed {0};
-	time_t m_maxFlyTime {0};
-	time_t m_maxRestTime {0};
-	time_t m_flyTime {0};
-	time_t m_restTime {0};
-	distance_t m_traveledDistance {0};
+	speed_t m_speed {0};
+	seconds_t m_flyTime {0};
+	seconds_t m_restTime {0};
 };
-using reindeerVector_t = std::vector<Reindeer>;
 
 
 
-Reindeer readReindeer(std::ifstream& file)// insert into reindeer constructor
-{
-	Reindeer result {};
-
-	file >> result.m_name;
-	constexpr auto fly_width {std::string_view("can fly ").length()};
-	file.ignore(fly_width);
-	file >> result.m_maxSpeed;
-	constexpr auto km_width {std::string_view("km/s for ").length()};
-	file.ignore(km_width);
-	file >> result.m_maxFlyTime;
-	constexpr auto rest_width {std::string_view("seconds, but then must rest for ").length()};
-	file.ignore(rest_width);
-	file >> result.m_maxRestTime;
-	constexpr auto end_width {std::string_view("seconds.\r\n").length()};
-	file.ignore(end_width);
-	EXPECT(!file.fail(), invalid_input_file_data);
-
-	result.m_flyTime = result.m_maxFlyTime;
-	result.m_restTime = result.m_maxRestTime;
-
-	return result;
-}
+//=== Class ReindeerRace =====================================================
+class ReindeerRace {
+public:
+// Constructors / destructor
+	ReindeerRace() = delete;
+	ReindeerRace(const ReindeerRace&) = delete;
+	ReindeerRace(ReindeerRace&&) = delete;
+	~ReindeerRace() = default;
+
+
+	// --- ReindeerRace() ---
+	explicit ReindeerRace(std::string_view input)
+	{
+		for (const auto line : Lines {input}) {
+			if (!line.empty()) {
+				m_reindeers.emplace_back(line);
+			}
+		}
+		EXPECT(!m_reindeers.empty(), invalid_input_file_data);
+	}
 
 
+// Operators
+	ReindeerRace& operator=(const ReindeerRace&) = delete;
+	ReindeerRace& operator=(ReindeerRace&&) = delete;
 
-reindeerVector_t readReindeerVector(std::ifstream file)
-{
-	reindeerVector_t result {};
 
-	while (!file.eof()) {
-		result.push_back(readReindeer(file));
+// Getter
+	// --- getMaxDistance() ---
+	distance_t getMaxDistance(const seconds_t time) const
+	{
+		distance_t result {0};
+		for (const auto& reindeer : m_reindeers) {
+			result = std::max(result, reindeer.getDistance(time));
+		}
+		return result;
 	}
 
-	return result;
-}
 
+	// --- getMaxScore() ---
+	/* The leaders only change, if another reindeer reaches them. As no reindeer moves backwards, another one can not do
+	so before it is where the leaders are now. So each other reindeer waits in a queue until this time and the leaders get
+	the points up to the next waiting time at once. */
+	score_t getMaxScore(const seconds_t time) const
+	{
+		using waiting_t = std::pair<seconds_t, std::size_t>;	// time to check again, reindeer
+		using waitingQueue_t = std::priority_queue<waiting_t, std::vector<waiting_t>, std::greater<waiting_t> >;
+
+		std::vector<score_t> scores(m_reindeers.size(), 0);
+		waitingQueue_t waiting {};
+		for (std::size_t i {0}; i < m_reindeers.size(); ++i) {
+			waiting.emplace(1, i);
+		}
+
+		std::vector<std::size_t> leaders {};
+		std::vector<std::size_t> candidates {};
+		for (seconds_t now {1}; now <= time;) {
+			// the lead can only be taken by the old leaders or a reindeer, which is done waiting
+			candidates.swap(leaders);
+			while (!waiting.empty() && waiting.top().first <= now) {
+				candidates.push_back(waiting.top().second);
+				waiting.pop();
+			}
+
+			distance_t lead {0};
+			for (const auto i : candidates) {
+				lead = std::max(lead, m_reindeers[i].getDistance(now));
+			}
+
+			leaders.clear();
+			for (const auto i : candidates) {
+				if (m_reindeers[i].getDistance(now) == lead) {
+					leaders.push_back(i);
+				} else {
+					waiting.emplace(m_reindeers[i].getTimeToReach(lead), i);
+				}
+			}
+			candidates.clear();
+
+			seconds_t next {waiting.empty() ? time + 1 : std::min(waiting.top().first, time + 1)};
+
+			// different leaders at the same position may split up with the next second
+			const auto& first {m_reindeers[leaders.front()]};
+			if (std::any_of(leaders.cbegin(), leaders.cend(), [&](const auto i) { return m_reindeers[i] != first; })) {
+				next = now + 1;
+			}
+
+			for (const auto i : leaders) {
+				scores[i] += next - now;
+			}
+			now = next;
+		}
+
+		return *std::max_element(scores.cbegin(), scores.cend());
+	}
 
 
-}/* anonymous namespace */
+private:
+// Variables
+	std::deque<Reindeer> m_reindeers {};		// a deque never moves its elements, when adding one
+};
+
+
+
+} /* anonymous namespace */
 
 
 
 //=== Class Day14 ============================================================
 // --- Day14::solve() ---
-void Day14::solve() // TODO: refactor
+void Day14::solve()
 {
 	try {
-		reindeerVector_t reindeers {readReindeerVector(m_IO.getInputFile())};
+		const ReindeerRace race {m_IO.getInputData()};
 		m_IO.printFileValid();
 
-		constexpr time_t raceTime {2503};
-
-		for (time_t i {0}; i < raceTime; ++i) {
-			std::for_each(reindeers.begin(), reindeers.end(), [](auto& rdeer) { // TODO: refactor
-				rdeer.fly();
-			});
-		}
-
-		const auto getMaxDistance = [&]() {
-			distance_t result {0};
-			std::for_each(reindeers.cbegin(), reindeers.cend(), [&](const auto& rdeer) {
-						result = std::max(result, rdeer.getTraveledDistance());
-					});
-			return result;
-		};
-		m_IO.printSolution(getMaxDistance(), EPart::Part1);
-
-		std::for_each(reindeers.begin(), reindeers.end(), [](auto& rdeer) {
-			rdeer.reset();
-		});
-
-		for (time_t i {0}; i < raceTime; ++i) {
-			std::for_each(reindeers.begin(), reindeers.end(), [](auto& rdeer) {
-				rdeer.fly();
-			});
-			const distance_t maxDistance {getMaxDistance()};
-			std::for_each(reindeers.begin(), reindeers.end(), [&](auto& rdeer) {
-				if (rdeer.getTraveledDistance() == maxDistance) {
-					++rdeer.score;
-				}
-			});
-		}
-		const auto getMaxScore = [&]() {
-			distance_t result {0};
-			std::for_each(reindeers.cbegin(), reindeers.cend(), [&](const auto& rdeer) {
-						result = std::max(result, rdeer.score);
-					});
-			return result;
-		};
-		m_IO.printSolution(getMaxScore(), EPart::Part2);
-
+		m_IO.printSolution(race.getMaxDistance(race_time), EPart::Part1);
+		m_IO.printSolution(race.getMaxScore(race_time), EPart::Part2);
 
 	} catch (const std::exception& err) {
 		m_IO.printError(err.what());
@@ -51,16 +51,15 @@ Your puzzle answer was 405.*/
 //=== Include ================================================================
 #include "Day16.h"
 
-#include <fstream>
 #include <iostream>
 #include <map>
-#include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
 
 #include "../aoc/BasicDefinitions.h"
 #include "../aoc/BasicIO.h"
+#include "../aoc/InputScanner.h"
 
 
 
@@ -89,7 +88,7 @@ public:
 
 
 	// --- Mfcsam() ---
-	explicit Mfcsam(std::ifstream input)
+	explicit Mfcsam(std::string_view input)
 	{
 		m_tickerTape.insert(std::make_pair("children", 3));		// @suppress("Avoid magic numbers")
 		m_tickerTape.insert(std::make_pair("cats", 7));			// @suppress("Avoid magic numbers")
@@ -102,10 +101,10 @@ public:
 		m_tickerTape.insert(std::make_pair("cars", 2));			// @suppress("Avoid magic numbers")
 		m_tickerTape.insert(std::make_pair("perfumes", 1));		// @suppress("Avoid magic numbers")
 
-		std::string buffer {""};
-		while (!input.eof()) {		// TODO: m_input as vector of class
-			std::getline(input, buffer);
-			m_input.push_back(buffer);
+		for (const auto line : Lines {input}) {		// TODO: m_input as vector of class
+			if (!line.empty()) {
+				m_input.push_back(line);
+			}
 		}
 	}
 
@@ -149,77 +148,49 @@ public:
 private:
 // Functions
 	// --- isAuntPart1() ---
-	IsAuntNum isAuntPart1(const std::string& input) const
+	IsAuntNum isAuntPart1(std::string_view input) const
 	{
-		std::stringstream strstream {input};
-		std::string strBuffer {};
-		IsAuntNum result {};
-
-		strstream >> strBuffer;
-		EXPECT(strBuffer == "Sue", "Invalid input. Each line should start with 'Sue '.");
-
-		strstream >> result.number;
-		EXPECT(!strstream.fail(), "Invalid input. Aunt is missing her number");
-
-		constexpr auto separator_width {std::string_view(": ").length()}; // ': ' or ', '
-
-		auto compareCompound = [&]() {
-			int intBuffer {};
-
-			strstream.ignore(separator_width);
-			strstream >> strBuffer;
-			strBuffer.pop_back(); // removes ':'
-			strstream >> intBuffer;
-			EXPECT(!strstream.fail(), "Invalid input. Could not read compound.");
+		return isAunt(input, [&](std::string_view compound, const int number) {
+			return m_tickerTape.at(compound) == number;
+		});
+	}
 
-			return m_tickerTape.at(strBuffer) == intBuffer;
-		};
 
-		while (!strstream.eof()) {
-			if (!compareCompound()) {
-				result.found = false;
-				return result;
+	// --- isAuntPart2() ---
+	IsAuntNum isAuntPart2(std::string_view input) const
+	{
+		return isAunt(input, [&](std::string_view compound, const int number) {
+			if (compound == "cats" || compound == "trees" ) {
+				return m_tickerTape.at(compound) < number;
+			} else if (compound == "pomeranians" || compound == "goldfish") {
+				return m_tickerTape.at(compound) > number;
+			} else {
+				return m_tickerTape.at(compound) == number;
 			}
-		}
-
-		return result;
+		});
 	}
 
 
-	// --- isAuntPart2() ---
-	IsAuntNum isAuntPart2(const std::string& input) const
+	// --- isAunt() ---
+	// Reads "Sue #: compound: #, compound: #, ..." and checks every compound
+	template<typename Func>
+	static IsAuntNum isAunt(std::string_view input, Func isMatching)
 	{
-		std::stringstream strstream {input};
-		std::string strBuffer {""};
-		int intBuffer {};
+		TokenScanner scanner {input};
 		IsAuntNum result {};
 
-		strstream >> strBuffer;
-		EXPECT(strBuffer == "Sue", "Invalid input. Each line should start with 'Sue '.");
+		EXPECT(scanner.skipIf("Sue "), "Invalid input. Each line should start with 'Sue '.");
+		result.number = scanner.nextInt<int>();
+		scanner.skip(":");
 
-		strstream >> result.number;
-		EXPECT(!strstream.fail(), "Invalid input. Aunt is missing her number");
-
-		constexpr auto separator_width {std::string_view(": ").length()}; // ': ' or ', '
-
-		auto compareCompound = [&]() {
-			strstream.ignore(separator_width);
-			strstream >> strBuffer;
-			strBuffer.pop_back(); // removes ':'
-			strstream >> intBuffer;
-			EXPECT(!strstream.fail(), "Invalid input. Could not read compound.");
-
-			if (strBuffer == "cats" || strBuffer == "trees" ) {
-				return m_tickerTape.at(strBuffer) < intBuffer;
-			} else if (strBuffer == "pomeranians" || strBuffer == "goldfish") {
-				return m_tickerTape.at(strBuffer) > intBuffer;
-			} else {
-				return m_tickerTape.at(strBuffer) == intBuffer;
-			}
-		};
+		while (!scanner.isEnd()) {
+			auto compound {scanner.nextToken()};
+			EXPECT(compound.back() == ':', "Invalid input. Could not read compound.");
+			compound.remove_suffix(1); // removes ':'
+			const auto number {scanner.nextInt<int>()};
+			scanner.skipIf(",");
 
-		while (!strstream.eof()) {
-			if (!compareCompound()) {
+			if (!isMatching(compound, number)) {
 				result.found = false;
 				return result;
 			}
@@ -230,8 +201,8 @@ private:
 
 
 // Variables
-	std::vector<std::string> m_input {};
-	std::map<std::string, int> m_tickerTape {};
+	std::vector<std::string_view> m_input {};			// views into the input data
+	std::map<std::string_view, int> m_tickerTape {};
 };
 
 
@@ -245,7 +216,7 @@ private:
 void Day16::solve()
 {
 	try {
-		Mfcsam mfcsam {m_IO.getInputFile()};
+		Mfcsam mfcsam {m_IO.getInputData()};
 		m_IO.printFileValid();
 
 		m_IO.printSolution(mfcsam.getAuntPart1(), EPart::Part1);
@@ -132,11 +132,14 @@ Your puzzle answer was 1006.*/
 //=== Include ================================================================
 #include "Day18.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
-#include <iterator>
 #include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "../aoc/BasicDefinitions.h"
 #include "../aoc/BasicIO.h"
@@ -150,56 +153,91 @@ namespace {
 
 
 
+//=== Types ==================================================================
+using word_t = std::uint64_t;
+using lightGrid_t = Grid<word_t>;		// each word holds 64 lights of a row
+using dimension_t = lightGrid_t::dimension_t;
+using lines_t = std::vector<std::string>;
+
+
+
 //=== Constants ==============================================================
-constexpr int grid_size {100};
+constexpr dimension_t word_bits {64};
+constexpr dimension_t border {1};		// words and rows of lights, which are off, around the grid
 
 
 
-//=== Types ==================================================================
-using lightGrid_t = Grid<signed char>;
+//=== Functions ==============================================================
+// --- readLines() ---
+// The size of the grid depends on the input, so larger grids can be animated, too
+lines_t readLines(std::ifstream& input)
+{
+	lines_t result {};
+	std::string buffer {};
+	while (std::getline(input, buffer)) {
+		if (!buffer.empty() && buffer.back() == '\r') {
+			buffer.pop_back();
+		}
+		if (!buffer.empty()) {
+			EXPECT(buffer.find_first_not_of(".#") == std::string::npos, invalid_input_file_data);
+			result.push_back(buffer);
+		}
+	}
+
+	EXPECT(!result.empty(), invalid_input_file_data);
+	for (const auto& line : result) {
+		EXPECT(line.length() == result.front().length(), invalid_input_file_data);
+	}
+	return result;
+}
+
+
+
+// --- fullAdder() ---
+// Adds three bits in each bit position of the words
+void fullAdder(const word_t a, const word_t b, const word_t c, word_t& sum, word_t& carry)
+{
+	const word_t half_sum {a ^ b};
+	sum = half_sum ^ c;
+	carry = (a & b) | (half_sum & c);
+}
 
 
 
-//=== Class InputData ========================================================
+//=== Class LightGrid ========================================================
+/* Game of Life on a bit packed grid: each word holds 64 lights of a row. The neighbours of all these lights are counted
+at once with bitwise adders, so no light is visited on its own. The grid has a border of words, which are always 0, so
+the neighbouring words above, below, left and right can be read without checking the edges of the grid. */
 class LightGrid {
 public:
 // Constructors / destructor
-	LightGrid() = default;
+	LightGrid() = delete;
 	LightGrid(const LightGrid&) = default;
 	LightGrid(LightGrid&&) = default;
 	~LightGrid() = default;
 
 
-	// --- InputData() ---
-	explicit LightGrid(std::ifstream input)
+	// --- LightGrid() ---
+	explicit LightGrid(const lines_t& lines) :
+			m_width {static_cast<dimension_t>(lines.front().length())},
+			m_lights {(m_width + word_bits - 1) / word_bits, static_cast<dimension_t>(lines.size()), border},
+			m_newLights {m_lights},
+			m_lastWordMask {(m_width % word_bits == 0) ? ~word_t {0} : (word_t {1} << (m_width % word_bits)) - 1}
 	{
-		char buffer {};
-		auto i {m_input.begin()};
-
-		while (!input.eof()) {
-			input >> buffer;
-			switch (buffer) {
-			case '.':
-				*i = 0;
-				std::advance(i, 1);
-				break;
-
-			case '#':
-				*i = 1;
-				std::advance(i, 1);
-				break;
-
-			case '\r':
-			case '\n':
-				// Do nothing
-				break;
-
-			default:
-				THROW_ERROR(invalid_input_file_data);
-				break;
+		for (dimension_t y {0}; y < m_lights.getHeight(); ++y) {
+			for (dimension_t x {0}; x < m_width; ++x) {
+				if (lines[y][x] == '#') {
+					turnOn(x, y);
+				}
 			}
 		}
-		m_new_lights = m_input;
+	}
+
+
+	// --- LightGrid() ---
+	explicit LightGrid(std::ifstream input) : LightGrid(readLines(input))
+	{
+		// Do nothing
 	}
 
 
@@ -210,78 +248,101 @@ public:
 
 // Functions
 	// --- accumulateData() ---
-	auto accumulateData() const
+	// Number of lights, which are on
+	lightGrid_t::accumulate_t accumulateData() const
 	{
-		return m_input.accumulateData();
+		lightGrid_t::accumulate_t result {0};
+		for (dimension_t y {0}; y < m_lights.getHeight(); ++y) {
+			for (const word_t word : m_lights.row(y)) {
+				result += __builtin_popcountll(word);
+			}
+		}
+		return result;
 	}
 
 
 	// --- animateLights() ---
 	void animateLights()
 	{
-		int numAdjacentLights {};
-
-		for (lightGrid_t::dimension_t j, i = 0; i < grid_size; ++i) {
-			for (j = 0; j < grid_size; ++j) {
-				numAdjacentLights = sumAdjacentLights(i, j);
-				signed char& currentLight = m_new_lights[lightGrid_t::Position {i, j}]; // just for readability
-
-				if (m_input[lightGrid_t::Position {i, j}] != 0) {
-					if ((numAdjacentLights == 2) || (numAdjacentLights == 3)) { // stay alive // @suppress("Avoid magic numbers")
-						currentLight = 1;
-					} else { // die
-						currentLight = 0;
-					}
-				} else {
-					if (numAdjacentLights == 3) { // be born // @suppress("Avoid magic numbers")
-						currentLight = 1;
-					} else { // stay dead
-						currentLight = 0;
-					}
-				}
-			}
-		}
-
-		m_input = m_new_lights;
-	}
+		const lightGrid_t& lights {m_lights};
+		const dimension_t words {lights.getWidth()};
 
+		for (dimension_t y {0}; y < lights.getHeight(); ++y) {
+			const word_t* const row {&lights[lightGrid_t::Position {0, y}]};
+			word_t* const result {&m_newLights[lightGrid_t::Position {0, y}]};
 
-	// --- sumAdjacentLights() ---
-	int sumAdjacentLights(lightGrid_t::dimension_t x, lightGrid_t::dimension_t y)
-	{
-		int result = m_input[lightGrid_t::Position {x, y}] ? -1 : 0; // if middle is alive, reduce by one, else it must have been excluded from loop
-
-		for (int j, i = -1; i < 2; ++i) {
-			for (j = -1; j < 2; ++j) {
-				try {
-					// May cause underflow, but catch should handle this nevertheless
-					if (m_input.at(lightGrid_t::Position {x + i, y + j}) != 0) {
-						++result;
-					}
-				} catch (const std::exception&) {
-					// Do nothing
-				}
+			for (dimension_t i {0}; i < words; ++i) {
+				result[i] = animateWord(row + i, lights.getStride());
 			}
+			result[words - 1] &= m_lastWordMask;	// lights behind the end of the row must stay off
 		}
 
-		return result;
+		std::swap(m_lights, m_newLights);	// moves only the containers, no lights are copied
 	}
 
 
 	// --- turnOnEdges() ---
 	void turnOnEdges()
 	{
-		m_input[Grid<signed char>::Position {0, 0}] = 1;
-		m_input[Grid<signed char>::Position {0, grid_size - 1}] = 1;
-		m_input[Grid<signed char>::Position {grid_size - 1, 0}] = 1;
-		m_input[Grid<signed char>::Position {grid_size - 1, grid_size - 1}] = 1;
+		const dimension_t last_x {m_width - 1};
+		const dimension_t last_y {m_lights.getHeight() - 1};
+
+		turnOn(0, 0);
+		turnOn(0, last_y);
+		turnOn(last_x, 0);
+		turnOn(last_x, last_y);
 	}
 
 
 private:
+// Functions
+	// --- turnOn() ---
+	void turnOn(const dimension_t x, const dimension_t y)
+	{
+		m_lights[lightGrid_t::Position {x / word_bits, y}] |= word_t {1} << (x % word_bits);
+	}
+
+
+	// --- animateWord() ---
+	// Calculates the next state of the word from the word itself and its neighbours, which may be in the border
+	static word_t animateWord(const word_t* const word, const std::size_t stride)
+	{
+		// neighbours at x - 1 and x + 1, moved to position x (including bits of the previous and next word)
+		const auto left = [](const word_t* const data) {
+			return (data[0] << 1) | (data[-1] >> (word_bits - 1));
+		};
+		const auto right = [](const word_t* const data) {
+			return (data[0] >> 1) | (data[1] << (word_bits - 1));
+		};
+		const word_t* const above {word - stride};
+		const word_t* const below {word + stride};
+
+		// count neighbours: top and bottom three, middle two lights
+		word_t top_ones {}, top_twos {};
+		fullAdder(left(above), above[0], right(above), top_ones, top_twos);
+		word_t bottom_ones {}, bottom_twos {};
+		fullAdder(left(below), below[0], right(below), bottom_ones, bottom_twos);
+		const word_t middle_left {left(word)};
+		const word_t middle_right {right(word)};
+		const word_t middle_ones {middle_left ^ middle_right};
+		const word_t middle_twos {middle_left & middle_right};
+
+		word_t ones {}, ones_carry {};
+		fullAdder(top_ones, middle_ones, bottom_ones, ones, ones_carry);
+		word_t twos {}, fours {};
+		fullAdder(top_twos, middle_twos, bottom_twos, twos, fours);
+
+		// neighbours = ones + 2 * (twos + ones_carry) + 4 * fours, only 2 or 3 neighbours are of interest
+		const word_t two_or_three {~fours & (twos ^ ones_carry)};
+		return two_or_three & (ones | word[0]);	// 3: be born or stay alive, 2: stay alive
+	}
+
+
 // Variables
-	lightGrid_t m_input {grid_size, grid_size};
-	lightGrid_t m_new_lights {grid_size, grid_size}; // to avoid multiple allocations
+	dimension_t m_width;					// Lights in each row
+	lightGrid_t m_lights;					// Current state
+	lightGrid_t m_newLights;				// Next state, to avoid multiple allocations
+	word_t m_lastWordMask;					// Lights of the last word of each row, which are part of the grid
 };
 
 
@@ -37,11 +37,15 @@ Your puzzle answer was 705600.*/
 //=== Include ================================================================
 #include "Day20.h"
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <vector>
 
 #include "../aoc/BasicDefinitions.h"
 #include "../aoc/BasicIO.h"
+#include "../aoc/ThreadPool.h"
 
 
 
@@ -53,46 +57,114 @@ namespace {
 
 //=== Types ==================================================================
 using uint_t = unsigned int;
+using presents_t = unsigned long long;
 
 
 
-//=== Functions ==============================================================
-// --- calculatePresents() ---
-// WARNING: takes (on my computer) about 10 min. to find the right solution
-// CHECK: How to make faster
-uint_t calculatePresents(unsigned int houseIndex)
-{
-	constexpr uint_t multiplicator {10};		// to save some operations, just do this once at the end
-	const uint_t loop_end {houseIndex / 2};		// elves between houseIndex/2 and houseIndex will not stop here
-	uint_t result = 1 + houseIndex;				// elves 1 and houseIndex will always stop here
+//=== Constants ==============================================================
+constexpr uint_t invalid_house {std::numeric_limits<uint_t>::max()};
+constexpr uint_t segment_size {1 << 18};		// Houses calculated by one task
 
-	for (uint_t i {2}; i <= loop_end; ++i) {
-		if (houseIndex % i == 0) {
-			result += i;
-		}
+
+
+//=== Class PresentSieve =====================================================
+/* Instead of searching the divisors of each house, each elf delivers its presents to all of its houses (like the sieve
+of Eratosthenes). The street is split into segments, so the segments can be calculated in parallel and each segment
+only needs a small array of houses. */
+class PresentSieve {
+public:
+// Constructors / destructor
+	PresentSieve() = delete;
+	PresentSieve(const PresentSieve&) = delete;
+	PresentSieve(PresentSieve&&) = delete;
+	~PresentSieve() = default;
+
+
+	// --- PresentSieve() ---
+	// maxHousesPerElf = 0: each elf visits infinitely many houses
+	PresentSieve(const uint_t presentsPerElf, const uint_t maxHousesPerElf) :
+			m_presentsPerElf {presentsPerElf}, m_maxHousesPerElf {maxHousesPerElf}
+	{
+		EXPECT(presentsPerElf != 0, "Each elf must deliver presents.");
 	}
 
-	return result * multiplicator;
-}
 
+// Operators
+	PresentSieve& operator=(const PresentSieve&) = delete;
+	PresentSieve& operator=(PresentSieve&&) = delete;
 
 
-// --- calculatePresentsPart2() ---
-uint_t calculatePresentsPart2(unsigned int houseIndex)
-{
-	constexpr uint_t max_presents_per_elf {50};
-	constexpr uint_t multiplicator {11};						// to save some operations, just do this once at the end
-	const uint_t loop_end {houseIndex / max_presents_per_elf};
-	uint_t result = houseIndex;									// Assume houseIndex > 50, skip first house
-
-	for (uint_t i {houseIndex / 2}; i >= loop_end; --i) {
-		if (houseIndex % i == 0) {
-			result += i;
+// Functions
+	// --- findHouse() ---
+	// Returns the lowest house getting at least minPresents
+	uint_t findHouse(const presents_t minPresents) const
+	{
+		// Elf n always visits house n (it is its first house), so house n gets at least n * presentsPerElf presents
+		const presents_t upper_bound {std::max<presents_t>(1, (minPresents + m_presentsPerElf - 1) / m_presentsPerElf)};
+		EXPECT(upper_bound < invalid_house, "Too many presents, can not calculate the houses.");
+		const auto last_house {static_cast<uint_t>(upper_bound)};
+
+		// Segments are started in ascending order, segments behind an already found house are skipped
+		const uint_t result {ThreadPool::getShared().findLowest(uint_t {1}, last_house, segment_size, invalid_house,
+				[this, minPresents](const uint_t first, const uint_t last) { return searchSegment(first, last, minPresents); })};
+
+		EXPECT(result != invalid_house, "Could not find a house.");	// should not happen, because of upper_bound
+		return result;
+	}
+
+
+private:
+// Functions
+	// --- searchSegment() ---
+	// Returns the lowest house in [first, last] getting at least minPresents
+	uint_t searchSegment(const uint_t first, const uint_t last, const presents_t minPresents) const
+	{
+		std::vector<presents_t> houses(last - first + 1, 0);
+
+		// Elves, who stopped before the first house of the segment, do not need to be checked
+		const uint_t first_elf {(m_maxHousesPerElf == 0) ? 1 : (first + m_maxHousesPerElf - 1) / m_maxHousesPerElf};
+		const uint_t length {last - first + 1};
+
+		// small elves visit several houses of the segment
+		for (uint_t elf {first_elf}; elf <= std::min(last, length); ++elf) {
+			const presents_t last_visit {(m_maxHousesPerElf == 0)
+				? last
+				: std::min<presents_t>(last, static_cast<presents_t>(elf) * m_maxHousesPerElf)};
+
+			// first house of the elf inside the segment
+			for (presents_t house {std::max(elf, (first + elf - 1) / elf * elf)}; house <= last_visit; house += elf) {
+				houses[house - first] += elf;
+			}
+		}
+
+		/* Big elves visit at most one house of the segment, so looping over them would check all elves up to last for
+		each segment. Instead loop over the number of the visit: for visit n the elves visiting the segment are
+		[first / n, last / n], so each segment needs O(length * log(last) + last / length) steps. */
+		const uint_t max_visit {(m_maxHousesPerElf == 0)
+			? last / (length + 1)
+			: std::min(last / (length + 1), m_maxHousesPerElf)};
+		for (uint_t visit {1}; visit <= max_visit; ++visit) {
+			const uint_t elf_begin {std::max({length + 1, first_elf, (first + visit - 1) / visit})};
+			for (uint_t elf {elf_begin}; elf <= last / visit; ++elf) {
+				houses[elf * visit - first] += elf;
+			}
 		}
+
+		// multiply only once per house
+		for (uint_t i {0}; i < houses.size(); ++i) {
+			if (houses[i] * m_presentsPerElf >= minPresents) {
+				return first + i;
+			}
+		}
+
+		return invalid_house;
 	}
 
-	return result * multiplicator;
-}
+
+// Variables
+	const uint_t m_presentsPerElf;		// Presents each elf delivers to each house multiplied with its number
+	const uint_t m_maxHousesPerElf;		// Houses visited by each elf, 0 = infinite
+};
 
 
 
@@ -105,22 +177,20 @@ uint_t calculatePresentsPart2(unsigned int houseIndex)
 void Day20::solve()
 {
 	try {
+		constexpr uint_t presents_per_elf_part1 {10};
+		constexpr uint_t presents_per_elf_part2 {11};
+		constexpr uint_t max_houses_per_elf_part2 {50};
+
 		uint_t input {};
 		m_IO.getInputFile() >> input;
 		EXPECT(input != 0, "Invalid input. Please check input file.");
 		m_IO.printFileValid();
 
-		uint_t houseIndex {2};
-		//uint_t houseIndex {665270}; // get headstart for debugging
-		while (calculatePresents(houseIndex) <= input) {
-			++houseIndex;
-		}
-		m_IO.printSolution(houseIndex, EPart::Part1);
+		const PresentSieve sievePart1 {presents_per_elf_part1, 0};
+		m_IO.printSolution(sievePart1.findHouse(input), EPart::Part1);
 
-		while (calculatePresentsPart2(houseIndex) <= input) {
-			++houseIndex;
-		}
-		m_IO.printSolution(houseIndex, EPart::Part2);
+		const PresentSieve sievePart2 {presents_per_elf_part2, max_houses_per_elf_part2};
+		m_IO.printSolution(sievePart2.findHouse(input), EPart::Part2);
 
 	} catch (const std::exception& err) {
 		m_IO.printError(err.what());